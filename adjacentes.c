@@ -8,46 +8,45 @@
  *********************************************************************/
 #include "header.h"
 
+#define CAP_INICIAL_ADJACENTES 4 // Capacidade do vetor de adjacências na primeira inserção
+
 #pragma region ADJACENTES
 
-#pragma region CriarAdjacente
+#pragma region PesoAdjacente
 
  /**
-  * @brief Cria um novo adjacente com um identificador e um peso especificados.
+  * @brief Calcula o peso de uma adjacência.
   *
-  * Esta funo aloca memria para um novo adjacente e inicializa os seus campos com os valores especificados.
-  * Se a alocao de memria falhar, a funo retorna `NULL`.
+  * O peso não é guardado em cada adjacência: é sempre derivado dos valores atuais dos dois vértices
+  * (valor da origem + valor do destino), pelo que nunca fica desatualizado quando um valor muda.
   *
-  * @param id O identificador do adjacente a ser criado.
-  * @param valor O valor da adjacncia.
-  * @param peso O peso da adjacncia.
-  * @return Apontador para o novo adjacente criado, ou `NULL` se a alocao de memria falhar.
+  * @param origem Apontador para o vértice de origem.
+  * @param destino Apontador para o vértice de destino.
+  * @return O peso da adjacência, ou 0 se um dos vértices for nulo.
   */
-Adjacente* CriarAdjacente(int id, int valor, int peso) {
-	Adjacente* adj = (Adjacente*)malloc(sizeof(Adjacente)); // Aloca memria para criar o adjacente
-	if (adj == NULL) return NULL;
-	// Inicializa o novo adjacente
-	adj->id = id;
-	adj->valor = valor;
-	adj->peso = peso;
-	adj->proximo = NULL;
-	return adj;
+TipoSoma PesoAdjacente(Vertice* origem, Vertice* destino) {
+	if (origem == NULL || destino == NULL) return 0;
+	return (TipoSoma)origem->valor + destino->valor;
 }
 
 #pragma endregion
 
-#pragma region DestruirAdjacente
+#pragma region DestruirAdjacentes
 
 /**
- * @brief Liberta a memria associada a um adjacente.
+ * @brief Liberta o vetor de adjacências de um vértice.
  *
- * Esta funo liberta a memria associada a um adjacente, que foi alocada anteriormente
- * utilizando a funo `malloc`.
+ * Os vetores que fazem parte de um bloco contíguo (ver ReordenarGrafo) não são libertados individualmente.
  *
- * @param adj Apontador para o adjacente a ser destrudo.
+ * @param v Apontador para o vértice.
  */
-void DestruirAdjacente(Adjacente* adj) {
-	free(adj);
+void DestruirAdjacentes(Vertice* v) {
+	if (v == NULL) return;
+	if (!v->adjEmBloco) free(v->adjacentes); // Os vetores de um bloco contíguo são libertados com o bloco
+	v->adjacentes = NULL;
+	v->numAdjacentes = 0;
+	v->capAdjacentes = 0;
+	v->adjEmBloco = false;
 }
 
 #pragma endregion
@@ -55,39 +54,27 @@ void DestruirAdjacente(Adjacente* adj) {
 #pragma region EliminarAdjacente
 
 /**
- * @brief Elimina uma adjacncia com um determinado identificador da lista de adjacncias.
+ * @brief Elimina uma adjacência com um determinado identificador do vetor de adjacências de um vértice.
  *
- * Esta funo procura e elimina uma adjacncia com o identificador especificado da lista de adjacncias.
- * Se a eliminao for bem-sucedida, o indicador de sucesso  definido como `true`.
+ * A adjacência eliminada é substituída pela última do vetor (eliminação por troca), em tempo constante
+ * depois de encontrada. A ordem das restantes adjacências pode por isso mudar.
+ * Se a eliminação for bem-sucedida, o indicador de sucesso é definido como `true`.
  *
- * @param listaAdj Apontador para o incio da lista de adjacncias.
- * @param idAdj O identificador da adjacncia a ser eliminada.
- * @param res Apontador para uma varivel booleana que indica o sucesso da eliminao.
- *            Ser definido como `true` se a adjacncia for encontrada e eliminada com sucesso, caso contrrio `false`.
- * @return Apontador para o incio atualizado da lista de adjacncias aps a eliminao.
+ * @param v Apontador para o vértice de origem.
+ * @param idAdj O identificador da adjacência a ser eliminada.
+ * @param res Apontador para uma variável booleana que indica o sucesso da eliminação.
+ *            Será definido como `true` se a adjacência for encontrada e eliminada com sucesso, caso contrário `false`.
+ * @return Apontador para o vértice.
  */
-Adjacente* EliminarAdjacente(Adjacente* listaAdj, int idAdj, bool* res) {
-	if (listaAdj == NULL) return NULL;
-	// Procura a adjacncia
-	Adjacente* aux = listaAdj;
-	Adjacente* anterior = NULL;
-	while (aux && aux->id != idAdj) {
-		anterior = aux; // O adjacente "anterior" passa a apontar para o adjacente que "aux" estava a apontar
-		aux = aux->proximo; // O adjacente "aux" passa a apontar para o prximo adjacente
-	}
-	if (!aux) return listaAdj; // A adjacncia no existe
-	// Apaga a adjacncia no incio
-	if (anterior == NULL) {
-		listaAdj = aux->proximo; // "listaAdj" passa a apontar para o adjacente seguinte de "aux", eliminando assim o primeiro adjacente da lista
-	}
-	else
-	{
-		// Apaga o vrtice
-		anterior->proximo = aux->proximo; // "anterior" passa a apontar para o adjacente seguinte ao qual estava a ser apontado por "aux", eliminando assim o adjacente pretendido
-	}
-	DestruirAdjacente(aux);
+Vertice* EliminarAdjacente(Vertice* v, IdVertice idAdj, bool* res) {
+	if (v == NULL) return NULL;
+	// Procura a adjacência
+	int i = 0;
+	while (i < v->numAdjacentes && v->adjacentes[i] != idAdj) i++;
+	if (i == v->numAdjacentes) return v; // A adjacência não existe
+	v->adjacentes[i] = v->adjacentes[--v->numAdjacentes]; // A última adjacência passa a ocupar a posição da eliminada
 	*res = true;
-	return listaAdj;
+	return v;
 }
 
 #pragma endregion
@@ -95,31 +82,23 @@ Adjacente* EliminarAdjacente(Adjacente* listaAdj, int idAdj, bool* res) {
 #pragma region EliminaTodosAdjacentes
 
 /**
- * @brief Elimina todas as adjacncias da lista de adjacncias.
+ * @brief Elimina todas as adjacências de um vértice.
  *
- * Esta funo percorre a lista de adjacncias e elimina todos os seus elementos.
- * Se a eliminao for bem-sucedida, o indicador de sucesso  definido como `true`.
+ * Esta função liberta o vetor de adjacências do vértice e deixa-o sem adjacências.
+ * Se a eliminação for bem-sucedida, o indicador de sucesso é definido como `true`.
  *
- * @param listaAdj Apontador para o incio da lista de adjacncias.
- * @param res Apontador para uma varivel booleana que indica o sucesso da eliminao.
- *            Ser definido como `true` se todas as adjacncias forem eliminadas com sucesso, caso contrrio `false`.
- * @return Apontador nulo aps a eliminao de todas as adjacncias.
+ * @param v Apontador para o vértice.
+ * @param res Apontador para uma variável booleana que indica o sucesso da eliminação.
+ *            Será definido como `true` se o vértice tinha adjacências e foram eliminadas, caso contrário `false`.
+ * @return Apontador para o vértice.
  */
-Adjacente* EliminaTodosAdjacentes(Adjacente* listaAdj, bool* res) {
+Vertice* EliminaTodosAdjacentes(Vertice* v, bool* res) {
 	*res = false;
-	if (listaAdj == NULL) return NULL;
-	// Percorre a lista de adjacncias
-	Adjacente* aux = listaAdj;
-	while (aux) {
-		if (aux) {
-			listaAdj = aux->proximo; // "listaAdj" passa a apontar para adjacente seguinte ao que "aux" estava a apontar, assim eliminando o adjacente apontado por "aux"
-		}
-		DestruirAdjacente(aux);
-		aux = listaAdj;
-	}
-	listaAdj = NULL;
-	*res = true;
-	return listaAdj;
+	if (v == NULL) return NULL;
+	bool tinhaAdjacentes = v->numAdjacentes > 0;
+	DestruirAdjacentes(v); // Liberta o vetor mesmo que esteja vazio (pode ter capacidade reservada)
+	*res = tinhaAdjacentes;
+	return v;
 }
 
 #pragma endregion
@@ -127,37 +106,38 @@ Adjacente* EliminaTodosAdjacentes(Adjacente* listaAdj, bool* res) {
 #pragma region InserirAdjacente
 
 /**
- * Insere um novo adjacente  lista de adjacncias.
+ * Insere um novo adjacente no vetor de adjacências de um vértice.
  *
- * Esta funo cria e insere um novo n adjacente  lista de adjacncias.
- * Se a lista de adjacncias estiver vazia, o novo n ser inserido no incio.
- * Caso contrrio, ser inserido no final da lista.
+ * Esta função acrescenta o identificador do destino no fim do vetor de adjacências do vértice.
+ * Quando o vetor está cheio, a sua capacidade é duplicada, pelo que o custo de cada inserção é
+ * constante em média. Se o vetor estava num bloco contíguo, passa a ter memória própria.
  *
- * @param listaAdj Apontador para a lista de adjacncias.
- * @param idDestino Identificador do n adjacente.
- * @param valor Valor do n adjacente.
- * @param peso Peso da aresta para o n adjacente.
- * @return Retorna um apontador para a lista de adjacncias atualizada.
+ * @param v Apontador para o vértice de origem.
+ * @param idDestino Identificador do vértice adjacente.
+ * @param res Apontador para uma variável booleana que será definida como verdadeira se a inserção for bem-sucedida.
+ * @return Retorna um apontador para o vértice.
  */
-Adjacente* InserirAdjacente(Adjacente* listaAdj, int idDestino, int valor, int peso) {
-	Adjacente* novoAdj;
-	if ((novoAdj = CriarAdjacente(idDestino, valor, peso)) == NULL) {
-		return listaAdj; // Se no conseguiu criar uma nova adjacncia
-	}
-	// Se a lista de adjacncias esta vazia
-	if (listaAdj == NULL) {
-		listaAdj = novoAdj; // Insere uma nova adjacncia do inicio
-	}
-	else {
-		// Por opco, inserir no fim da LA
-		Adjacente* aux = listaAdj;
-		while (aux->proximo != NULL)
-		{
-			aux = aux->proximo; // O adjacente "aux" passa a apontar para o prximo adjacente
+Vertice* InserirAdjacente(Vertice* v, IdVertice idDestino, bool* res) {
+	*res = false;
+	if (v == NULL) return NULL;
+	if (v->numAdjacentes == v->capAdjacentes) {
+		int capacidade = v->capAdjacentes > 0 ? v->capAdjacentes * 2 : CAP_INICIAL_ADJACENTES;
+		IdVertice* adjacentes;
+		if (v->adjEmBloco) { // Um vetor do bloco contíguo não pode crescer: copia-o para memória própria
+			adjacentes = (IdVertice*)malloc(capacidade * sizeof(IdVertice));
+			if (adjacentes != NULL && v->numAdjacentes > 0) memcpy(adjacentes, v->adjacentes, v->numAdjacentes * sizeof(IdVertice));
+		}
+		else {
+			adjacentes = (IdVertice*)realloc(v->adjacentes, capacidade * sizeof(IdVertice));
 		}
-		aux->proximo = novoAdj; // "aux" fica a apontar para o "novoAdj"(adjacente inserido anteriormente no final da linha)
+		if (adjacentes == NULL) return v; // Se não conseguiu aumentar o vetor de adjacências
+		v->adjacentes = adjacentes;
+		v->capAdjacentes = capacidade;
+		v->adjEmBloco = false;
 	}
-	return listaAdj;
+	v->adjacentes[v->numAdjacentes++] = idDestino; // Por opção, inserir no fim do vetor
+	*res = true;
+	return v;
 }
 
 #pragma endregion
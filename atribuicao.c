@@ -0,0 +1,248 @@
+/*********************************************************************
+ * @file   atribuicao.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define FATOR_EPSILON 5 // Fator de redução do incremento mínimo dos lances entre fases
+
+#pragma region ATRIBUICAO
+
+#pragma region Auxiliares
+
+/**
+ * Benefício (na escala interna) de atribuir a coluna j à linha i. As linhas e colunas acrescentadas para tornar a
+ * matriz quadrada têm benefício 0.
+ */
+static long long Beneficio(Atribuicao* a, const TipoValor* valores, int i, int j) {
+	if (i >= a->linhas || j >= a->colunas) return 0;
+	return (long long)valores[(size_t)i * a->colunas + j] * (a->n + 1);
+}
+
+/**
+ * Calcula o lance de uma linha: a coluna com maior benefício líquido (benefício menos preço) e o preço que a linha
+ * está disposta a pagar por ela (o preço atual mais a diferença para a segunda melhor coluna, mais epsilon).
+ */
+static void CalcularLance(Atribuicao* a, const TipoValor* valores, int i, long long epsilon, int* coluna, long long* lance) {
+	long long melhor = LLONG_MIN, segundo = LLONG_MIN;
+	int melhorColuna = 0;
+	for (int j = 0; j < a->n; j++) {
+		long long liquido = Beneficio(a, valores, i, j) - a->precos[j];
+		if (liquido > melhor) {
+			segundo = melhor;
+			melhor = liquido;
+			melhorColuna = j;
+		}
+		else if (liquido > segundo) segundo = liquido;
+	}
+	*coluna = melhorColuna;
+	*lance = segundo == LLONG_MIN ? a->precos[melhorColuna] + epsilon : a->precos[melhorColuna] + (melhor - segundo) + epsilon;
+}
+
+/**
+ * Desfaz as atribuições que não cumprem a condição de epsilon-complementaridade com os preços atuais (a coluna
+ * atribuída tem de estar a menos de epsilon da melhor coluna da linha). Usado no arranque a quente, depois de os
+ * valores mudarem.
+ */
+static void ValidarAtribuicao(Atribuicao* a, const TipoValor* valores, long long epsilon, int numThreads) {
+#ifndef _OPENMP
+	(void)numThreads; // Só é usado pelas diretivas OpenMP
+#endif
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 16)
+	for (int i = 0; i < a->n; i++) {
+		int j = a->colunaDe[i];
+		if (j < 0) continue;
+		long long melhor = LLONG_MIN;
+		for (int k = 0; k < a->n; k++) {
+			long long liquido = Beneficio(a, valores, i, k) - a->precos[k];
+			if (liquido > melhor) melhor = liquido;
+		}
+		if (Beneficio(a, valores, i, j) - a->precos[j] < melhor - epsilon) a->colunaDe[i] = -1;
+	}
+	for (int j = 0; j < a->n; j++) {
+		int i = a->linhaDe[j];
+		if (i >= 0 && a->colunaDe[i] != j) a->linhaDe[j] = -1;
+	}
+}
+
+/**
+ * Fase do leilão com um incremento mínimo fixo: enquanto houver linhas sem coluna, todas as linhas livres fazem o
+ * seu lance em paralelo (cada uma só lê os preços), e depois cada coluna é atribuída ao maior lance que recebeu.
+ */
+static void FaseLeilao(Atribuicao* a, const TipoValor* valores, long long epsilon, int numThreads, int* livres, int* alvo,
+	long long* lance, long long* maiorLance, int* vencedor) {
+#ifndef _OPENMP
+	(void)numThreads; // Só é usado pelas diretivas OpenMP
+#endif
+	int n = a->n;
+	while (true) {
+		int numLivres = 0;
+		for (int i = 0; i < n; i++) {
+			if (a->colunaDe[i] < 0) livres[numLivres++] = i;
+		}
+		if (numLivres == 0) break;
+		// Lances (em paralelo)
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 8)
+		for (int k = 0; k < numLivres; k++) {
+			CalcularLance(a, valores, livres[k], epsilon, &alvo[k], &lance[k]);
+		}
+		// Atribuição de cada coluna ao maior lance
+		for (int k = 0; k < numLivres; k++) {
+			int j = alvo[k];
+			if (vencedor[j] < 0 || lance[k] > maiorLance[j]) {
+				maiorLance[j] = lance[k];
+				vencedor[j] = livres[k];
+			}
+		}
+		for (int k = 0; k < numLivres; k++) {
+			int j = alvo[k];
+			if (vencedor[j] < 0) continue; // Coluna já tratada
+			int anterior = a->linhaDe[j];
+			if (anterior >= 0) a->colunaDe[anterior] = -1; // A linha que tinha a coluna volta a estar livre
+			a->linhaDe[j] = vencedor[j];
+			a->colunaDe[vencedor[j]] = j;
+			a->precos[j] = maiorLance[j];
+			vencedor[j] = -1;
+		}
+	}
+}
+
+#pragma endregion
+
+#pragma region CriarAtribuicao
+
+/**
+ * @brief Cria o estado de um problema de atribuição (escolha de um valor por linha e por coluna de uma matriz).
+ *
+ * @param linhas O número de linhas da matriz.
+ * @param colunas O número de colunas da matriz.
+ * @return Apontador para o estado criado, a destruir com DestruirAtribuicao, ou `NULL` se as dimensões forem
+ *         inválidas ou se a alocação de memória falhar.
+ */
+Atribuicao* CriarAtribuicao(int linhas, int colunas) {
+	if (linhas <= 0 || colunas <= 0) return NULL;
+	Atribuicao* a = (Atribuicao*)calloc(1, sizeof(Atribuicao));
+	if (a == NULL) return NULL;
+	a->linhas = linhas;
+	a->colunas = colunas;
+	a->n = linhas > colunas ? linhas : colunas;
+	a->colunaDe = (int*)malloc(a->n * sizeof(int));
+	a->linhaDe = (int*)malloc(a->n * sizeof(int));
+	a->precos = (long long*)calloc(a->n, sizeof(long long));
+	if (a->colunaDe == NULL || a->linhaDe == NULL || a->precos == NULL) {
+		DestruirAtribuicao(a);
+		return NULL;
+	}
+	for (int i = 0; i < a->n; i++) {
+		a->colunaDe[i] = -1;
+		a->linhaDe[i] = -1;
+	}
+	a->resolvida = false;
+	return a;
+}
+
+#pragma endregion
+
+#pragma region ResolverAtribuicao
+
+/**
+ * @brief Escolhe um valor em cada linha da matriz, sem repetir colunas, com a maior soma possível (algoritmo de leilão).
+ *
+ * Cada linha livre faz um lance pela coluna com maior benefício líquido (valor menos preço), subindo o preço dessa
+ * coluna; os lances de uma ronda são calculados em paralelo. Os valores são multiplicados por n + 1, pelo que com o
+ * incremento mínimo final de 1 a solução é ótima. A frio o incremento começa grande e vai diminuindo (escalonamento
+ * de epsilon); a quente são aproveitados os preços e as atribuições da última resolução (desfazendo só as que deixaram
+ * de ser válidas com os novos valores) e o leilão corre logo com o incremento final, pelo que depois de alterar um
+ * valor ou uma linha converge muito mais depressa. Se a matriz não for quadrada, as linhas ou colunas em falta
+ * têm valor 0 (só `min(linhas, colunas)` valores são escolhidos).
+ *
+ * @param a O apontador para o estado do problema (as dimensões da matriz são as indicadas em CriarAtribuicao).
+ * @param valores Os valores da matriz, por linhas (`valores[i * colunas + j]`).
+ * @param aQuente Se for `true` e já houver uma solução anterior, arranca a partir dela.
+ * @param numThreads Número de threads (0 para o número por omissão).
+ * @return `true` se a atribuição foi calculada, `false` se o estado ou os valores forem nulos ou se a alocação de memória falhar.
+ */
+bool ResolverAtribuicao(Atribuicao* a, const TipoValor* valores, bool aQuente, int numThreads) {
+	if (a == NULL || valores == NULL) return false;
+	int n = a->n;
+	int* livres = (int*)malloc(n * sizeof(int));
+	int* alvo = (int*)malloc(n * sizeof(int));
+	long long* lance = (long long*)malloc(n * sizeof(long long));
+	long long* maiorLance = (long long*)malloc(n * sizeof(long long));
+	int* vencedor = (int*)malloc(n * sizeof(int));
+	bool resolvida = false;
+	if (livres != NULL && alvo != NULL && lance != NULL && maiorLance != NULL && vencedor != NULL) {
+		int threads = 1;
+#ifdef _OPENMP
+		threads = numThreads > 0 ? numThreads : omp_get_max_threads();
+#else
+		(void)numThreads;
+#endif
+		for (int j = 0; j < n; j++) vencedor[j] = -1;
+		if (aQuente && a->resolvida) {
+			ValidarAtribuicao(a, valores, 1, threads);
+			FaseLeilao(a, valores, 1, threads, livres, alvo, lance, maiorLance, vencedor);
+		}
+		else {
+			long long maior = 1; // Maior benefício em valor absoluto
+			for (int i = 0; i < a->linhas; i++) {
+				for (int j = 0; j < a->colunas; j++) {
+					long long b = Beneficio(a, valores, i, j);
+					if (b < 0) b = -b;
+					if (b > maior) maior = b;
+				}
+			}
+			for (int j = 0; j < n; j++) a->precos[j] = 0;
+			for (long long epsilon = maior / 2 > 1 ? maior / 2 : 1; ; epsilon /= FATOR_EPSILON) {
+				if (epsilon < 1) epsilon = 1;
+				for (int i = 0; i < n; i++) { // Cada fase recomeça as atribuições, mantendo os preços
+					a->colunaDe[i] = -1;
+					a->linhaDe[i] = -1;
+				}
+				FaseLeilao(a, valores, epsilon, threads, livres, alvo, lance, maiorLance, vencedor);
+				if (epsilon == 1) break;
+			}
+		}
+		a->soma = 0;
+		for (int i = 0; i < a->linhas; i++) {
+			int j = a->colunaDe[i];
+			if (j < a->colunas) a->soma += valores[(size_t)i * a->colunas + j];
+		}
+		a->resolvida = true;
+		resolvida = true;
+	}
+	free(livres);
+	free(alvo);
+	free(lance);
+	free(maiorLance);
+	free(vencedor);
+	return resolvida;
+}
+
+#pragma endregion
+
+#pragma region DestruirAtribuicao
+
+/**
+ * @brief Liberta a memória associada ao estado de um problema de atribuição.
+ *
+ * @param a O apontador para o estado a destruir.
+ */
+void DestruirAtribuicao(Atribuicao* a) {
+	if (a == NULL) return;
+	free(a->colunaDe);
+	free(a->linhaDe);
+	free(a->precos);
+	free(a);
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
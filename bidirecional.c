@@ -0,0 +1,171 @@
+/*********************************************************************
+ * @file   bidirecional.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region BIDIRECIONAL
+
+#pragma region CriarPesquisaBidirecional
+
+ /**
+  * @brief Cria o estado das pesquisas bidirecionais num grafo compacto.
+  *
+  * Os vetores auxiliares são alocados uma única vez e reutilizados por todas as pesquisas: cada pesquisa
+  * usa um novo selo para distinguir os vértices que alcançou, pelo que não é preciso limpá-los.
+  * O grafo compacto não pode ser destruído enquanto o estado for usado.
+  *
+  * @param gc Apontador para o grafo compacto (com as arestas nos dois sentidos).
+  * @return Apontador para o estado criado, a destruir com DestruirPesquisaBidirecional, ou `NULL` se o grafo
+  *         for nulo ou se a alocação de memória falhar.
+  */
+PesquisaBidirecional* CriarPesquisaBidirecional(GrafoCompacto* gc) {
+	if (gc == NULL) return NULL;
+	PesquisaBidirecional* p = (PesquisaBidirecional*)calloc(1, sizeof(PesquisaBidirecional));
+	if (p == NULL) return NULL;
+	int n = gc->numVertices;
+	p->gc = gc;
+	p->selo = 0;
+	for (int s = 0; s < 2; s++) {
+		p->marca[s] = (int*)calloc(n + 1, sizeof(int));
+		p->anterior[s] = (int*)malloc((n + 1) * sizeof(int));
+		p->distancia[s] = (int*)malloc((n + 1) * sizeof(int));
+		p->fila[s] = (int*)malloc((n + 1) * sizeof(int));
+		if (p->marca[s] == NULL || p->anterior[s] == NULL || p->distancia[s] == NULL || p->fila[s] == NULL) {
+			DestruirPesquisaBidirecional(p);
+			return NULL;
+		}
+	}
+	return p;
+}
+
+#pragma endregion
+
+#pragma region CaminhoBidirecional
+
+/**
+ * @brief Procura o caminho com menos arestas entre dois vértices, com duas pesquisas em largura simultâneas.
+ *
+ * Uma pesquisa parte da origem pelas arestas de saída e a outra parte do destino pelas arestas de entrada.
+ * Em cada passo é expandido um nível completo da fronteira mais pequena, até as duas pesquisas se encontrarem.
+ * Num grafo grande isto visita em geral muito menos vértices do que uma pesquisa só a partir da origem.
+ * A soma devolvida é a soma dos valores dos vértices do caminho (como em CalcularSomaCaminho).
+ *
+ * @param p O apontador para o estado das pesquisas.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Caminho encontrado.
+ *        -  0: Não há caminho entre os dois vértices.
+ *        - -1: Um ou ambos os vértices não existem no grafo (ou o estado é nulo).
+ *        - -3: Falta de memória.
+ * @return Retorna um apontador para o resultado com o caminho e a sua soma, a destruir com DestruirResultado,
+ *         ou NULL se não houver caminho.
+ */
+Resultado* CaminhoBidirecional(PesquisaBidirecional* p, IdVertice idOrigem, IdVertice idDestino, int* res) {
+	*res = -1;
+	if (p == NULL) return NULL;
+	GrafoCompacto* gc = p->gc;
+	int extremo[2] = { IndiceGrafoCompacto(gc, idOrigem), IndiceGrafoCompacto(gc, idDestino) };
+	if (extremo[0] < 0 || extremo[1] < 0) return NULL;
+	if (p->selo == INT_MAX) { // Os selos esgotaram-se: limpar as marcas e recomeçar
+		for (int s = 0; s < 2; s++) memset(p->marca[s], 0, gc->numVertices * sizeof(int));
+		p->selo = 0;
+	}
+	int selo = ++p->selo;
+	int cabeca[2] = { 0, 0 }, fim[2] = { 0, 0 };
+	for (int s = 0; s < 2; s++) {
+		int v = extremo[s];
+		p->marca[s][v] = selo;
+		p->anterior[s][v] = -1;
+		p->distancia[s][v] = 0;
+		p->fila[s][fim[s]++] = v;
+	}
+	int encontro = extremo[0] == extremo[1] ? extremo[0] : -1; // Vértice onde as duas pesquisas se encontram
+	int melhor = INT_MAX; // Número de arestas do melhor caminho encontrado
+	while (encontro < 0 && cabeca[0] < fim[0] && cabeca[1] < fim[1]) {
+		// Expandir um nível completo da fronteira mais pequena
+		int s = fim[0] - cabeca[0] <= fim[1] - cabeca[1] ? 0 : 1;
+		int* inicio = s == 0 ? gc->inicioAdj : gc->inicioAnt;
+		int* vizinhos = s == 0 ? gc->destinos : gc->origens;
+		int fimNivel = fim[s];
+		while (cabeca[s] < fimNivel) {
+			int v = p->fila[s][cabeca[s]++];
+			for (int k = inicio[v]; k < inicio[v + 1]; k++) {
+				int w = vizinhos[k];
+				if (p->marca[s][w] == selo) continue;
+				p->marca[s][w] = selo;
+				p->anterior[s][w] = v;
+				p->distancia[s][w] = p->distancia[s][v] + 1;
+				p->fila[s][fim[s]++] = w;
+				// Se a outra pesquisa já alcançou w, há um caminho; o nível é terminado para escolher o mais curto
+				if (p->marca[1 - s][w] == selo && p->distancia[s][w] + p->distancia[1 - s][w] < melhor) {
+					melhor = p->distancia[s][w] + p->distancia[1 - s][w];
+					encontro = w;
+				}
+			}
+		}
+	}
+	if (encontro < 0) {
+		*res = 0;
+		return NULL;
+	}
+	// Construir o caminho: da origem ao encontro (pelos antecessores, invertido) e do encontro ao destino
+	*res = -3;
+	Resultado* caminho = (Resultado*)malloc(sizeof(Resultado));
+	IdVertice* percurso = (IdVertice*)malloc((p->distancia[0][encontro] + p->distancia[1][encontro] + 1) * sizeof(IdVertice));
+	if (caminho == NULL || percurso == NULL) {
+		free(caminho);
+		free(percurso);
+		return NULL;
+	}
+	int tamanho = p->distancia[0][encontro] + 1;
+	TipoSoma soma = 0;
+	int i = tamanho;
+	for (int v = encontro; v >= 0; v = p->anterior[0][v]) {
+		percurso[--i] = gc->ids[v];
+		soma += gc->valores[v];
+	}
+	for (int v = p->anterior[1][encontro]; v >= 0; v = p->anterior[1][v]) {
+		percurso[tamanho++] = gc->ids[v];
+		soma += gc->valores[v];
+	}
+	caminho->soma = soma;
+	caminho->caminho = gc->vertices != NULL ? gc->vertices[extremo[1]] : NULL;
+	caminho->grafo = gc->grafo;
+	caminho->percurso = percurso;
+	caminho->tamanho = tamanho;
+	caminho->exato = true;
+	*res = 1;
+	return caminho;
+}
+
+#pragma endregion
+
+#pragma region DestruirPesquisaBidirecional
+
+/**
+ * @brief Liberta a memória associada ao estado das pesquisas bidirecionais.
+ *
+ * O grafo compacto não é alterado.
+ *
+ * @param p O apontador para o estado a destruir.
+ */
+void DestruirPesquisaBidirecional(PesquisaBidirecional* p) {
+	if (p == NULL) return;
+	for (int s = 0; s < 2; s++) {
+		free(p->marca[s]);
+		free(p->anterior[s]);
+		free(p->distancia[s]);
+		free(p->fila[s]);
+	}
+	free(p);
+}
+
+#pragma endregion
+
+#pragma endregion
@@ -13,43 +13,39 @@
 #pragma region BuscarProfundidade
 
  /**
-  * Funo para realizar uma busca em profundidade num grafo a partir de um vrtice dado.
+  * Função para realizar uma busca em profundidade num grafo a partir de um vértice dado.
   *
-  * Esta funo implementa uma busca em profundidade num grafo, comeando a partir de um vrtice inicial
-  * e procurando por um vrtice de destino. Ela marca os vrtices visitados, acumula a soma dos valores
-  * dos vrtices visitados e verifica se o vrtice de destino  alcanvel a partir do vrtice inicial.
+  * Esta função implementa uma busca em profundidade num grafo, começando a partir de um vértice inicial
+  * e procurando por um vértice de destino. Ela marca os vértices visitados, acumula a soma dos valores
+  * dos vértices visitados e verifica se o vértice de destino é alcançável a partir do vértice inicial.
   *
-  * @param v O vrtice inicial da busca.
-  * @param idDestino O identificador do vrtice de destino a ser encontrado.
-  * @param visitado Um array de booleanos indicando se cada vrtice foi visitado ou no.
-  * @param soma Um apontador para a soma acumulada dos valores dos vrtices visitados.
-  * @param g O apontador para o grafo onde a busca ser realizada.
-  * @return Retorna verdadeiro se o vrtice de destino for encontrado a partir do vrtice inicial, caso contrrio, retorna falso.
+  * @param v O vértice inicial da busca.
+  * @param idDestino O identificador do vértice de destino a ser encontrado.
+  * @param visitado Um array de booleanos, indexado pelo índice denso de cada vértice, indicando se o vértice foi visitado ou não.
+  * @param soma Um apontador para a soma acumulada dos valores dos vértices visitados.
+  * @param g O apontador para o grafo onde a busca será realizada.
+  * @return Retorna verdadeiro se o vértice de destino for encontrado a partir do vértice inicial, caso contrário, retorna falso.
   */
-bool BuscarProfundidade(Vertice* v, int idDestino, bool* visitado, int* soma, Grafo* g) {
-	// Marcar o vrtice atual como visitado
-	visitado[v->id] = true;
-	// Adicionar o valor do vrtice atual  soma
+bool BuscarProfundidade(Vertice* v, IdVertice idDestino, bool* visitado, TipoSoma* soma, Grafo* g) {
+	// Marcar o vértice atual como visitado (pelo seu índice denso)
+	visitado[v->indice] = true;
+	// Adicionar o valor do vértice atual à soma
 	*soma += v->valor;
-	// Se o vrtice atual for o destino, retornar true
+	// Se o vértice atual for o destino, retornar true
 	if (v->id == idDestino) {
 		return true;
 	}
-	// Percorrer os vrtices adjacentes
-	Adjacente* adjacente = v->proxAdjacente;
-	while (adjacente != NULL) {
-		// Obter o vrtice adjacente
-		Vertice* verticeAdjacente = OndeEstaVerticeGrafo(g, adjacente->id);
+	// Percorrer os vértices adjacentes
+	for (int i = 0; i < v->numAdjacentes; i++) {
+		// Obter o vértice adjacente
+		Vertice* verticeAdjacente = OndeEstaVerticeGrafo(g, v->adjacentes[i]);
 
-		// Se o vrtice adjacente no foi visitado, realizar uma busca em profundidade a partir dele
-		if (!visitado[adjacente->id] && BuscarProfundidade(verticeAdjacente, idDestino, visitado, soma, g)) {
+		// Se o vértice adjacente não foi visitado, realizar uma busca em profundidade a partir dele
+		if (verticeAdjacente != NULL && !visitado[verticeAdjacente->indice] && BuscarProfundidade(verticeAdjacente, idDestino, visitado, soma, g)) {
 			return true;
 		}
-
-		// Avanar para o prximo vrtice adjacente
-		adjacente = adjacente->proximo;
 	}
-	// Se nenhum caminho para o destino foi encontrado a partir deste vrtice, retornar false
+	// Se nenhum caminho para o destino foi encontrado a partir deste vértice, retornar false
 	return false;
 }
 
@@ -58,45 +54,49 @@ bool BuscarProfundidade(Vertice* v, int idDestino, bool* visitado, int* soma, Gr
 #pragma region CalcularSomaCaminho
 
 /**
- * Funo para calcular a soma dos valores ao longo do caminho entre dois vrtices num grafo.
+ * Função para calcular a soma dos valores ao longo do caminho entre dois vértices num grafo.
  *
- * Esta funo calcula a soma dos valores dos vrtices ao longo do caminho entre dois vrtices
- * num grafo utilizando uma busca em profundidade. Ela verifica se os vrtices de origem e destino
- * existem no grafo, marca os vrtices visitados durante a busca, realiza a busca em profundidade
- * para encontrar o caminho entre os vrtices de origem e destino e retorna a soma dos valores dos
- * vrtices no caminho encontrado.
+ * Esta função calcula a soma dos valores dos vértices ao longo do caminho entre dois vértices
+ * num grafo utilizando uma busca em profundidade. Ela verifica se os vértices de origem e destino
+ * existem no grafo, marca os vértices visitados durante a busca, realiza a busca em profundidade
+ * para encontrar o caminho entre os vértices de origem e destino e retorna a soma dos valores dos
+ * vértices no caminho encontrado.
  *
- * @param g O apontador para o grafo onde a busca ser realizada.
- * @param idOrigem O identificador do vrtice de origem.
- * @param idDestino O identificador do vrtice de destino.
- * @return Retorna a soma dos valores dos vrtices no caminho entre os vrtices de origem e destino.
- *         Retorna -1 se um ou ambos os vrtices no existirem no grafo ou se no houver caminho entre eles.
+ * @param g O apontador para o grafo onde a busca será realizada.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @return Retorna a soma dos valores dos vértices no caminho entre os vértices de origem e destino.
+ *         Retorna -1 se um ou ambos os vértices não existirem no grafo ou se não houver caminho entre eles.
  */
-int CalcularSomaCaminho(Grafo* g, int idOrigem, int idDestino) {
-	// Verificar se os vrtices de origem e destino existem no grafo
+TipoSoma CalcularSomaCaminho(Grafo* g, IdVertice idOrigem, IdVertice idDestino) {
+	RASTREIO_INICIO(inicio);
+	// Verificar se os vértices de origem e destino existem no grafo
 	Vertice* verticeOrigem = OndeEstaVerticeGrafo(g, idOrigem);
 	Vertice* verticeDestino = OndeEstaVerticeGrafo(g, idDestino);
 	if (verticeOrigem == NULL || verticeDestino == NULL) {
-		printf("Um ou ambos os vrtices no existem no grafo.\n");
+		printf("Um ou ambos os vértices não existem no grafo.\n");
+		RASTREIO_FIM(inicio, "CalcularSomaCaminho");
 		return -1;
 	}
-	// Inicializar um array para marcar os vrtices visitados durante a busca em profundidade
-	int numVertices = g->totVertices;
+	// Inicializar um array, indexado pelos índices densos, para marcar os vértices visitados durante a busca em profundidade
+	int numVertices = g->numVertices;
 	bool* visitado = (bool*)malloc(numVertices * sizeof(bool));
 	for (int i = 0; i < numVertices; ++i) {
 		visitado[i] = false;
 	}
 	// Inicializar a soma como zero
-	int soma = 0;
-	// Realizar a busca em profundidade para encontrar o caminho entre os vrtices de origem e destino
+	TipoSoma soma = 0;
+	// Realizar a busca em profundidade para encontrar o caminho entre os vértices de origem e destino
 	if (!BuscarProfundidade(verticeOrigem, idDestino, visitado, &soma, g)) {
-		printf("No h caminho entre os vrtices %d e %d.\n", idOrigem, idDestino);
+		printf("Não há caminho entre os vértices %lld e %lld.\n", idOrigem, idDestino);
 		free(visitado);
+		RASTREIO_FIM(inicio, "CalcularSomaCaminho");
 		return -1;
 	}
-	// Libertar a memria alocada para o array de visitados
+	// Libertar a memória alocada para o array de visitados
 	free(visitado);
-	// Retornar a soma dos vrtices no caminho
+	RASTREIO_FIM(inicio, "CalcularSomaCaminho");
+	// Retornar a soma dos vértices no caminho
 	return soma;
 }
 
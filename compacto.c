@@ -0,0 +1,182 @@
+/*********************************************************************
+ * @file   compacto.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region GRAFO COMPACTO
+
+#pragma region CriarGrafoCompacto
+
+ /**
+  * @brief Cria uma cópia compacta (só de leitura) de um grafo.
+  *
+  * Esta função copia os vértices e as adjacências do grafo para vetores contíguos, no formato
+  * de linhas comprimidas: os destinos das adjacências do vértice de índice `i` ocupam as posições
+  * `inicioAdj[i]` a `inicioAdj[i + 1] - 1` do vetor `destinos`, guardados como índices e não como
+  * identificadores. Os índices são os índices densos dos vértices no grafo original.
+  * As mesmas arestas são também guardadas no sentido inverso: as origens das arestas que chegam ao
+  * vértice de índice `i` ocupam as posições `inicioAnt[i]` a `inicioAnt[i + 1] - 1` do vetor `origens`.
+  * As adjacências para vértices que não existem no grafo são ignoradas. Fica também registado se alguma aresta tem
+  * peso negativo (ver VerificarPesosNegativosCompacto).
+  *
+  * @param g Apontador para o grafo a copiar.
+  * @return Apontador para o grafo compacto criado, ou `NULL` se o grafo for nulo ou se a alocação de memória falhar.
+  */
+GrafoCompacto* CriarGrafoCompacto(Grafo* g) {
+	if (g == NULL) return NULL;
+	GrafoCompacto* gc = (GrafoCompacto*)calloc(1, sizeof(GrafoCompacto));
+	if (gc == NULL) return NULL;
+	// Contar as adjacências
+	int n = g->numVertices, m = 0;
+	for (int i = 0; i < n; i++) {
+		m += g->porIndice[i]->numAdjacentes;
+	}
+	gc->grafo = g;
+	gc->numVertices = n;
+	gc->ids = (IdVertice*)malloc((n + 1) * sizeof(IdVertice));
+	gc->valores = (TipoValor*)malloc((n + 1) * sizeof(TipoValor));
+	gc->vertices = (Vertice**)malloc((n + 1) * sizeof(Vertice*));
+	gc->inicioAdj = (int*)malloc((n + 1) * sizeof(int));
+	gc->destinos = (int*)malloc((m + 1) * sizeof(int));
+	gc->inicioAnt = (int*)calloc(n + 2, sizeof(int));
+	gc->origens = (int*)malloc((m + 1) * sizeof(int));
+	if (gc->ids == NULL || gc->valores == NULL || gc->vertices == NULL || gc->inicioAdj == NULL || gc->destinos == NULL
+		|| gc->inicioAnt == NULL || gc->origens == NULL) {
+		DestruirGrafoCompacto(gc);
+		return NULL;
+	}
+	// Copiar os vértices e as adjacências, convertendo os identificadores em índices densos
+	m = 0;
+	for (int i = 0; i < n; i++) {
+		Vertice* v = g->porIndice[i];
+		gc->ids[i] = v->id;
+		gc->valores[i] = v->valor;
+		gc->vertices[i] = v;
+		gc->inicioAdj[i] = m;
+		for (int k = 0; k < v->numAdjacentes; k++) {
+			int destino = IndiceVerticeGrafo(g, v->adjacentes[k]);
+			if (destino >= 0) gc->destinos[m++] = destino;
+		}
+	}
+	gc->inicioAdj[n] = m;
+	gc->numArestas = m;
+	// Arestas no sentido inverso (ordenação por contagem dos destinos)
+	for (int k = 0; k < m; k++) gc->inicioAnt[gc->destinos[k] + 2]++;
+	for (int i = 0; i < n; i++) gc->inicioAnt[i + 2] += gc->inicioAnt[i + 1];
+	for (int i = 0; i < n; i++) { // "inicioAnt[w + 1]" serve de posição de escrita e acaba no início de w + 1
+		for (int k = gc->inicioAdj[i]; k < gc->inicioAdj[i + 1]; k++) gc->origens[gc->inicioAnt[gc->destinos[k] + 1]++] = i;
+	}
+	VerificarPesosNegativosCompacto(gc);
+	return gc;
+}
+
+#pragma endregion
+
+#pragma region PesosNegativosCompacto
+
+/**
+ * @brief Verifica se alguma aresta do grafo compacto tem peso negativo e guarda a resposta em "pesosNegativos".
+ *
+ * O peso de uma aresta é a soma dos valores dos dois vértices (ver PesoAdjacente). A verificação é feita por
+ * CriarGrafoCompacto; quem substituir o vetor "valores" deve voltar a chamá-la, e os valores isolados devem ser
+ * alterados com AlterarValorGrafoCompacto. Assim as pesquisas que exigem pesos não negativos (CaminhoPesoMinimoCompacto)
+ * não precisam de percorrer todas as arestas.
+ *
+ * @param gc Apontador para o grafo compacto.
+ * @return `true` se houver alguma aresta de peso negativo, caso contrário `false`.
+ */
+bool VerificarPesosNegativosCompacto(GrafoCompacto* gc) {
+	if (gc == NULL) return false;
+	gc->pesosNegativos = false;
+	for (int v = 0; v < gc->numVertices && !gc->pesosNegativos; v++) {
+		for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+			if ((TipoSoma)gc->valores[v] + gc->valores[gc->destinos[k]] < 0) {
+				gc->pesosNegativos = true; // Basta uma aresta
+				break;
+			}
+		}
+	}
+	return gc->pesosNegativos;
+}
+
+/**
+ * @brief Altera o valor de um vértice do grafo compacto, mantendo "pesosNegativos" atualizado.
+ *
+ * Só mudam os pesos das arestas que saem do vértice ou que chegam a ele, pelo que só essas são verificadas. O grafo
+ * só é percorrido se antes tinha arestas de peso negativo e as do vértice deixaram de o ser (a procura termina na
+ * primeira aresta negativa encontrada).
+ *
+ * @param gc Apontador para o grafo compacto.
+ * @param indice O índice do vértice (ver IndiceGrafoCompacto).
+ * @param valor O novo valor do vértice.
+ */
+void AlterarValorGrafoCompacto(GrafoCompacto* gc, int indice, TipoValor valor) {
+	if (gc == NULL || indice < 0 || indice >= gc->numVertices) return;
+	gc->valores[indice] = valor;
+	bool negativa = false;
+	for (int k = gc->inicioAdj[indice]; k < gc->inicioAdj[indice + 1] && !negativa; k++) {
+		negativa = (TipoSoma)valor + gc->valores[gc->destinos[k]] < 0;
+	}
+	for (int k = gc->inicioAnt[indice]; k < gc->inicioAnt[indice + 1] && !negativa; k++) {
+		negativa = (TipoSoma)gc->valores[gc->origens[k]] + valor < 0;
+	}
+	if (negativa) gc->pesosNegativos = true;
+	else if (gc->pesosNegativos) VerificarPesosNegativosCompacto(gc); // A aresta negativa podia ser deste vértice
+}
+
+#pragma endregion
+
+#pragma region IndiceGrafoCompacto
+
+/**
+ * @brief Obtém o índice de um vértice no grafo compacto a partir do seu identificador.
+ *
+ * Os índices do grafo compacto são os índices densos do grafo original, pelo que a procura é feita
+ * na tabela de identificadores do grafo original, a não ser que o grafo compacto tenha a sua própria
+ * tabela (as versões publicadas de um grafo versionado não podem consultar o grafo, que vai mudando).
+ *
+ * @param gc Apontador para o grafo compacto.
+ * @param idVertice O identificador do vértice a procurar.
+ * @return O índice do vértice, ou -1 se não existir.
+ */
+int IndiceGrafoCompacto(GrafoCompacto* gc, IdVertice idVertice) {
+	if (gc == NULL) return -1;
+	int indice = gc->tabelaIds != NULL ? ObterIndiceTabelaIds(gc->tabelaIds, idVertice) : IndiceVerticeGrafo(gc->grafo, idVertice);
+	return indice < gc->numVertices ? indice : -1;
+}
+
+#pragma endregion
+
+#pragma region DestruirGrafoCompacto
+
+/**
+ * @brief Liberta a memória associada a um grafo compacto.
+ *
+ * O grafo original não é alterado.
+ *
+ * @param gc Apontador para o grafo compacto a ser destruído.
+ */
+void DestruirGrafoCompacto(GrafoCompacto* gc) {
+	if (gc == NULL) return;
+	free(gc->ids);
+	free(gc->valores);
+	free(gc->vertices);
+	free(gc->inicioAdj);
+	free(gc->destinos);
+	free(gc->inicioAnt);
+	free(gc->origens);
+	if (gc->tabelaIds != NULL) {
+		DestruirTabelaIds(gc->tabelaIds);
+		free(gc->tabelaIds);
+	}
+	free(gc);
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,291 @@
+/*********************************************************************
+ * @file   componentes.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region COMPONENTES
+
+#pragma region ComponentesFortementeLigadas
+
+ /**
+  * @brief Calcula as componentes fortemente ligadas de um grafo compacto (algoritmo de Tarjan).
+  *
+  * A pesquisa em profundidade é feita com uma pilha explícita, para não esgotar a pilha de chamadas
+  * em grafos grandes. As componentes são numeradas por ordem topológica do grafo das componentes:
+  * uma aresta entre componentes diferentes vai sempre de uma componente de número menor para uma de número maior.
+  *
+  * @param gc Apontador para o grafo compacto.
+  * @param numComponentes Apontador onde é guardado o número de componentes encontradas.
+  * @return Vetor com a componente de cada índice de vértice (a libertar com `free`), ou `NULL` se a alocação de memória falhar.
+  */
+int* ComponentesFortementeLigadas(GrafoCompacto* gc, int* numComponentes) {
+	*numComponentes = 0;
+	if (gc == NULL) return NULL;
+	int n = gc->numVertices;
+	int* componente = (int*)malloc((n + 1) * sizeof(int));
+	int* ordem = (int*)malloc((n + 1) * sizeof(int)); // Ordem de descoberta de cada vértice (-1 se ainda não foi visitado)
+	int* baixo = (int*)malloc((n + 1) * sizeof(int)); // Menor ordem alcançável a partir da subárvore do vértice
+	int* pilhaTarjan = (int*)malloc((n + 1) * sizeof(int)); // Vértices ainda sem componente atribuída
+	int* pilhaChamadas = (int*)malloc((n + 1) * sizeof(int)); // Vértices da pesquisa em profundidade em curso
+	int* proximaAdj = (int*)malloc((n + 1) * sizeof(int)); // Próxima adjacência a explorar de cada vértice
+	if (componente == NULL || ordem == NULL || baixo == NULL || pilhaTarjan == NULL || pilhaChamadas == NULL || proximaAdj == NULL) {
+		free(componente);
+		componente = NULL;
+	}
+	else {
+		int contador = 0, topoTarjan = 0, total = 0;
+		for (int v = 0; v < n; v++) {
+			ordem[v] = -1;
+			componente[v] = -1;
+		}
+		for (int raiz = 0; raiz < n; raiz++) {
+			if (ordem[raiz] >= 0) continue;
+			int topoChamadas = 0;
+			pilhaChamadas[topoChamadas++] = raiz;
+			ordem[raiz] = baixo[raiz] = contador++;
+			proximaAdj[raiz] = gc->inicioAdj[raiz];
+			pilhaTarjan[topoTarjan++] = raiz;
+			while (topoChamadas > 0) {
+				int v = pilhaChamadas[topoChamadas - 1];
+				if (proximaAdj[v] < gc->inicioAdj[v + 1]) {
+					int w = gc->destinos[proximaAdj[v]++];
+					if (ordem[w] < 0) { // Descer para um vértice novo
+						ordem[w] = baixo[w] = contador++;
+						proximaAdj[w] = gc->inicioAdj[w];
+						pilhaTarjan[topoTarjan++] = w;
+						pilhaChamadas[topoChamadas++] = w;
+					}
+					else if (componente[w] < 0 && ordem[w] < baixo[v]) { // Aresta para um vértice ainda na pilha
+						baixo[v] = ordem[w];
+					}
+					continue;
+				}
+				// Todas as adjacências de v foram exploradas
+				topoChamadas--;
+				if (topoChamadas > 0) {
+					int pai = pilhaChamadas[topoChamadas - 1];
+					if (baixo[v] < baixo[pai]) baixo[pai] = baixo[v];
+				}
+				if (baixo[v] == ordem[v]) { // v é a raiz de uma componente
+					int w;
+					do {
+						w = pilhaTarjan[--topoTarjan];
+						componente[w] = total;
+					} while (w != v);
+					total++;
+				}
+			}
+		}
+		// O algoritmo de Tarjan encontra as componentes por ordem topológica inversa
+		for (int v = 0; v < n; v++) componente[v] = total - 1 - componente[v];
+		*numComponentes = total;
+	}
+	free(ordem);
+	free(baixo);
+	free(pilhaTarjan);
+	free(pilhaChamadas);
+	free(proximaAdj);
+	return componente;
+}
+
+#pragma endregion
+
+#pragma region CaminhoSomaMaximaComponentes
+
+// Estado partilhado pelas pesquisas dentro de uma componente
+typedef struct PesquisaComponente {
+	GrafoCompacto* gc;
+	int* componente; // Componente de cada vértice
+	int atual; // Componente onde decorre a pesquisa
+	bool* noCaminho; // Vértices do caminho em construção
+	TipoSoma* fim; // Melhor soma de um caminho que termina em cada vértice
+	int* entrada; // Vértice por onde esse melhor caminho entrou na componente do vértice
+	int* pilha; // Caminho em construção (só na reconstrução)
+	int profundidade; // Número de vértices em "pilha"
+} PesquisaComponente;
+
+/**
+ * Função para percorrer todos os caminhos simples dentro de uma componente a partir de um vértice de entrada.
+ *
+ * Cada vértice alcançado atualiza a melhor soma de um caminho que termina nele e o vértice de entrada desse caminho.
+ *
+ * @param p O apontador para o estado da pesquisa.
+ * @param v O vértice a visitar.
+ * @param soma A soma do caminho até antes de v (incluindo o que vem das componentes anteriores).
+ * @param origem O vértice por onde o caminho entrou na componente.
+ */
+static void BuscarNaComponente(PesquisaComponente* p, int v, TipoSoma soma, int origem) {
+	GrafoCompacto* gc = p->gc;
+	p->noCaminho[v] = true;
+	soma += gc->valores[v];
+	if (soma > p->fim[v]) {
+		p->fim[v] = soma;
+		p->entrada[v] = origem;
+	}
+	for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+		int w = gc->destinos[k];
+		if (p->componente[w] == p->atual && !p->noCaminho[w]) {
+			BuscarNaComponente(p, w, soma, origem);
+		}
+	}
+	p->noCaminho[v] = false;
+}
+
+/**
+ * Função para reencontrar, dentro de uma componente, um caminho simples até um destino com uma soma dada.
+ *
+ * Usada só na reconstrução do caminho final: o caminho encontrado fica em `p->pilha`.
+ *
+ * @param p O apontador para o estado da pesquisa.
+ * @param v O vértice a visitar.
+ * @param destino O vértice onde o caminho deve terminar.
+ * @param falta A soma que o caminho ainda tem de acumular a partir de v (inclusive).
+ * @return Retorna true se o caminho foi encontrado.
+ */
+static bool ReconstruirNaComponente(PesquisaComponente* p, int v, int destino, TipoSoma falta) {
+	GrafoCompacto* gc = p->gc;
+	p->noCaminho[v] = true;
+	p->pilha[p->profundidade++] = v;
+	falta -= gc->valores[v];
+	if (v == destino && falta == 0) return true;
+	for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+		int w = gc->destinos[k];
+		if (p->componente[w] == p->atual && !p->noCaminho[w] && ReconstruirNaComponente(p, w, destino, falta)) {
+			return true;
+		}
+	}
+	p->profundidade--;
+	p->noCaminho[v] = false;
+	return false;
+}
+
+/**
+ * Função para encontrar o caminho com a soma máxima de valores num grafo, decompondo-o em componentes fortemente ligadas.
+ *
+ * Um caminho simples atravessa cada componente fortemente ligada no máximo uma vez, entrando por um vértice e
+ * saindo por outro (ou pelo mesmo). A pesquisa exaustiva fica assim limitada ao interior de cada componente:
+ * para cada vértice de entrada são percorridos os caminhos simples dentro da sua componente, partindo da melhor
+ * soma com que se pode chegar a esse vértice (ou de zero, se o caminho começar ali). As somas de saída são depois
+ * propagadas pelas arestas entre componentes, por ordem topológica, como numa programação dinâmica sobre um grafo
+ * acíclico. O resultado é o mesmo da pesquisa exaustiva de CaminhoSomaMaxima, mas o custo exponencial passa a
+ * depender do tamanho da maior componente e não do grafo inteiro. Tal como em CaminhoSomaMaxima, se nenhum caminho
+ * tiver soma positiva o resultado tem soma 0, sem vértice final e com o percurso vazio.
+ *
+ * @param g O apontador para o grafo onde o caminho com a soma máxima será procurado.
+ * @param numComponentes Apontador onde é guardado o número de componentes (pode ser NULL).
+ * @param maiorComponente Apontador onde é guardado o número de vértices da maior componente (pode ser NULL).
+ * @return Retorna um apontador para o resultado com o caminho de soma máxima, a destruir com DestruirResultado.
+ *         Retorna NULL se o grafo for nulo ou vazio, ou se não for possível alocar memória.
+ */
+Resultado* CaminhoSomaMaximaComponentes(Grafo* g, int* numComponentes, int* maiorComponente) {
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	if (gc == NULL) return NULL;
+	int n = gc->numVertices;
+	int total = 0;
+	int* componente = n > 0 ? ComponentesFortementeLigadas(gc, &total) : NULL;
+	int* inicioComp = (int*)calloc(total + 2, sizeof(int)); // Posição em "porComponente" do primeiro vértice de cada componente
+	int* porComponente = (int*)malloc((n + 1) * sizeof(int)); // Vértices agrupados por componente
+	TipoSoma* chegada = (TipoSoma*)malloc((n + 1) * sizeof(TipoSoma)); // Melhor soma com que se pode entrar em cada vértice
+	int* anterior = (int*)malloc((n + 1) * sizeof(int)); // Vértice da componente anterior de onde vem essa melhor soma
+	PesquisaComponente p = { gc, componente, 0, NULL, NULL, NULL, NULL, 0 };
+	p.noCaminho = (bool*)calloc(n + 1, sizeof(bool));
+	p.fim = (TipoSoma*)malloc((n + 1) * sizeof(TipoSoma));
+	p.entrada = (int*)malloc((n + 1) * sizeof(int));
+	p.pilha = (int*)malloc((n + 1) * sizeof(int));
+	Resultado* res = NULL;
+	if (componente != NULL && inicioComp != NULL && porComponente != NULL && chegada != NULL && anterior != NULL
+		&& p.noCaminho != NULL && p.fim != NULL && p.entrada != NULL && p.pilha != NULL) {
+		// Agrupar os vértices por componente (ordenação por contagem)
+		int maior = 0;
+		for (int v = 0; v < n; v++) inicioComp[componente[v] + 1]++;
+		for (int c = 0; c < total; c++) {
+			if (inicioComp[c + 1] > maior) maior = inicioComp[c + 1];
+			inicioComp[c + 1] += inicioComp[c];
+		}
+		for (int v = 0; v < n; v++) porComponente[inicioComp[componente[v]]++] = v;
+		for (int c = total; c > 0; c--) inicioComp[c] = inicioComp[c - 1];
+		inicioComp[0] = 0;
+		for (int v = 0; v < n; v++) {
+			chegada[v] = 0; // Um caminho pode sempre começar em v
+			anterior[v] = -1;
+			p.fim[v] = SOMA_MIN;
+			p.entrada[v] = -1;
+		}
+		// Percorrer as componentes por ordem topológica
+		int melhorFim = -1;
+		for (int c = 0; c < total; c++) {
+			p.atual = c;
+			for (int i = inicioComp[c]; i < inicioComp[c + 1]; i++) {
+				int u = porComponente[i];
+				BuscarNaComponente(&p, u, chegada[u], u);
+			}
+			// Propagar as somas de saída para as componentes seguintes
+			for (int i = inicioComp[c]; i < inicioComp[c + 1]; i++) {
+				int w = porComponente[i];
+				if (melhorFim < 0 || p.fim[w] > p.fim[melhorFim]) melhorFim = w;
+				for (int k = gc->inicioAdj[w]; k < gc->inicioAdj[w + 1]; k++) {
+					int x = gc->destinos[k];
+					if (componente[x] != c && p.fim[w] > chegada[x]) {
+						chegada[x] = p.fim[w];
+						anterior[x] = w;
+					}
+				}
+			}
+		}
+		if (melhorFim >= 0 && p.fim[melhorFim] <= 0) melhorFim = -1; // Como em CaminhoSomaMaxima, só conta uma soma positiva
+		if (numComponentes != NULL) *numComponentes = total;
+		if (maiorComponente != NULL) *maiorComponente = maior;
+		// Reconstruir o caminho, troço a troço, da última componente para a primeira
+		res = (Resultado*)malloc(sizeof(Resultado));
+		IdVertice* percurso = (IdVertice*)malloc((n + 1) * sizeof(IdVertice));
+		if (res != NULL && percurso != NULL) {
+			int tamanho = 0;
+			int saida = melhorFim;
+			while (saida >= 0) {
+				int u = p.entrada[saida];
+				p.atual = componente[u];
+				p.profundidade = 0;
+				ReconstruirNaComponente(&p, u, saida, p.fim[saida] - chegada[u]);
+				for (int i = 0; i < p.profundidade; i++) p.noCaminho[p.pilha[i]] = false;
+				for (int i = p.profundidade - 1; i >= 0; i--) percurso[tamanho++] = gc->ids[p.pilha[i]];
+				saida = anterior[u];
+			}
+			for (int i = 0; i < tamanho / 2; i++) { // O percurso foi construído do fim para o início
+				IdVertice aux = percurso[i];
+				percurso[i] = percurso[tamanho - 1 - i];
+				percurso[tamanho - 1 - i] = aux;
+			}
+			res->soma = melhorFim >= 0 ? p.fim[melhorFim] : 0;
+			res->caminho = melhorFim >= 0 ? gc->vertices[melhorFim] : NULL;
+			res->grafo = g;
+			res->percurso = percurso;
+			res->tamanho = tamanho;
+			res->exato = true;
+		}
+		else {
+			free(res);
+			free(percurso);
+			res = NULL;
+		}
+	}
+	free(componente);
+	free(inicioComp);
+	free(porComponente);
+	free(chegada);
+	free(anterior);
+	free(p.noCaminho);
+	free(p.fim);
+	free(p.entrada);
+	free(p.pilha);
+	DestruirGrafoCompacto(gc);
+	return res;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,310 @@
+/*********************************************************************
+ * @file   distancias.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#define ARIDADE_HEAP 4 // Número de filhos de cada nó do heap
+
+#pragma region DISTANCIAS
+
+// Heap de mínimos de aridade 4, indexado pelos vértices (permite diminuir a chave de um vértice já inserido)
+typedef struct HeapDistancias {
+	int* vertices; // Vértices guardados no heap
+	int* posicao; // Posição de cada vértice no heap (-1 se não estiver no heap)
+	TipoSoma* chave; // Distância provisória de cada vértice (a chave do heap)
+	int tamanho; // Número de vértices no heap
+} HeapDistancias;
+
+#pragma region Auxiliares
+
+/**
+ * Coloca um vértice numa posição do heap, atualizando a sua posição.
+ */
+static void ColocarHeap(HeapDistancias* h, int i, int v) {
+	h->vertices[i] = v;
+	h->posicao[v] = i;
+}
+
+/**
+ * Sobe o vértice da posição i até o pai ter uma chave menor ou igual.
+ */
+static void SubirHeap(HeapDistancias* h, int i) {
+	int v = h->vertices[i];
+	while (i > 0) {
+		int pai = (i - 1) / ARIDADE_HEAP;
+		if (h->chave[h->vertices[pai]] <= h->chave[v]) break;
+		ColocarHeap(h, i, h->vertices[pai]);
+		i = pai;
+	}
+	ColocarHeap(h, i, v);
+}
+
+/**
+ * Desce o vértice da posição i até todos os filhos terem chaves maiores ou iguais.
+ */
+static void DescerHeap(HeapDistancias* h, int i) {
+	int v = h->vertices[i];
+	while (true) {
+		int primeiro = i * ARIDADE_HEAP + 1;
+		if (primeiro >= h->tamanho) break;
+		int menor = primeiro;
+		int ultimo = primeiro + ARIDADE_HEAP < h->tamanho ? primeiro + ARIDADE_HEAP : h->tamanho;
+		for (int f = primeiro + 1; f < ultimo; f++) {
+			if (h->chave[h->vertices[f]] < h->chave[h->vertices[menor]]) menor = f;
+		}
+		if (h->chave[h->vertices[menor]] >= h->chave[v]) break;
+		ColocarHeap(h, i, h->vertices[menor]);
+		i = menor;
+	}
+	ColocarHeap(h, i, v);
+}
+
+/**
+ * Insere um vértice no heap, ou diminui a sua chave se já lá estiver.
+ */
+static void InserirOuDiminuirHeap(HeapDistancias* h, int v, TipoSoma chave) {
+	h->chave[v] = chave;
+	if (h->posicao[v] < 0) {
+		h->vertices[h->tamanho] = v;
+		h->posicao[v] = h->tamanho++;
+	}
+	SubirHeap(h, h->posicao[v]);
+}
+
+/**
+ * Retira do heap o vértice com a menor chave.
+ */
+static int RetirarMinimoHeap(HeapDistancias* h) {
+	int v = h->vertices[0];
+	h->posicao[v] = -1;
+	h->tamanho--;
+	if (h->tamanho > 0) {
+		ColocarHeap(h, 0, h->vertices[h->tamanho]);
+		DescerHeap(h, 0);
+	}
+	return v;
+}
+
+/**
+ * Cria o resultado com o caminho que termina em "destino", seguindo os antecessores até à origem.
+ */
+static Resultado* CriarResultadoCaminho(GrafoCompacto* gc, int* anterior, int destino, TipoSoma peso) {
+	Resultado* res = (Resultado*)malloc(sizeof(Resultado));
+	IdVertice* percurso = (IdVertice*)malloc((gc->numVertices + 1) * sizeof(IdVertice));
+	if (res == NULL || percurso == NULL) {
+		free(res);
+		free(percurso);
+		return NULL;
+	}
+	int tamanho = 0;
+	for (int v = destino; v >= 0; v = anterior[v]) percurso[tamanho++] = gc->ids[v];
+	for (int i = 0; i < tamanho / 2; i++) { // O percurso foi construído do fim para o início
+		IdVertice aux = percurso[i];
+		percurso[i] = percurso[tamanho - 1 - i];
+		percurso[tamanho - 1 - i] = aux;
+	}
+	res->soma = peso;
+	res->caminho = gc->vertices != NULL ? gc->vertices[destino] : NULL;
+	res->grafo = gc->grafo;
+	res->percurso = percurso;
+	res->tamanho = tamanho;
+	res->exato = true;
+	return res;
+}
+
+#pragma endregion
+
+#pragma region CaminhoPesoMinimo
+
+/**
+ * @brief Calcula o caminho de menor peso entre dois vértices de um grafo compacto (algoritmo de Dijkstra).
+ *
+ * O peso de um caminho é a soma dos pesos das suas arestas, sendo o peso de cada aresta a soma dos valores
+ * dos dois vértices (ver PesoAdjacente). A pesquisa usa um heap de aridade 4 e termina assim que o destino é
+ * retirado do heap, porque a sua distância já não pode diminuir. O algoritmo exige pesos não negativos, o que é
+ * consultado em "pesosNegativos" (calculado quando o grafo compacto é criado ou os valores mudam), sem percorrer
+ * as arestas. O grafo compacto só é lido, pelo que pode ser uma versão publicada de um grafo versionado.
+ *
+ * @param gc O apontador para o grafo compacto.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Caminho encontrado.
+ *        -  0: Não há caminho entre os dois vértices.
+ *        - -1: Um ou ambos os vértices não existem no grafo.
+ *        - -2: O grafo tem uma aresta de peso negativo.
+ *        - -3: Falta de memória.
+ * @return Retorna um apontador para o resultado (peso em "soma" e vértices em "percurso"), a destruir com
+ *         DestruirResultado, ou NULL se não houver caminho.
+ */
+Resultado* CaminhoPesoMinimoCompacto(GrafoCompacto* gc, IdVertice idOrigem, IdVertice idDestino, int* res) {
+	*res = -1;
+	int origem = IndiceGrafoCompacto(gc, idOrigem);
+	int destino = IndiceGrafoCompacto(gc, idDestino);
+	if (origem < 0 || destino < 0) return NULL;
+	*res = -2;
+	if (gc->pesosNegativos) return NULL;
+	*res = -3;
+	int n = gc->numVertices;
+	HeapDistancias h = { NULL, NULL, NULL, 0 };
+	h.vertices = (int*)malloc((n + 1) * sizeof(int));
+	h.posicao = (int*)malloc((n + 1) * sizeof(int));
+	h.chave = (TipoSoma*)malloc((n + 1) * sizeof(TipoSoma));
+	int* anterior = (int*)malloc((n + 1) * sizeof(int));
+	bool* fixado = (bool*)calloc(n + 1, sizeof(bool)); // Vértices cuja distância já é definitiva
+	Resultado* caminho = NULL;
+	if (h.vertices != NULL && h.posicao != NULL && h.chave != NULL && anterior != NULL && fixado != NULL) {
+		*res = 0;
+		for (int v = 0; v < n; v++) {
+			h.posicao[v] = -1;
+			h.chave[v] = SOMA_MAX;
+			anterior[v] = -1;
+		}
+		InserirOuDiminuirHeap(&h, origem, 0);
+		while (h.tamanho > 0) {
+			int v = RetirarMinimoHeap(&h);
+			fixado[v] = true;
+			if (v == destino) { // Saída antecipada: a distância do destino é definitiva
+				caminho = CriarResultadoCaminho(gc, anterior, destino, h.chave[destino]);
+				*res = caminho != NULL ? 1 : -3;
+				break;
+			}
+			for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+				int w = gc->destinos[k];
+				if (fixado[w]) continue;
+				TipoSoma peso = (TipoSoma)gc->valores[v] + gc->valores[w];
+				if (h.chave[v] + peso < h.chave[w]) {
+					anterior[w] = v;
+					InserirOuDiminuirHeap(&h, w, h.chave[v] + peso);
+				}
+			}
+		}
+	}
+	free(h.vertices);
+	free(h.posicao);
+	free(h.chave);
+	free(anterior);
+	free(fixado);
+	return caminho;
+}
+
+/**
+ * @brief Calcula o caminho de menor peso entre dois vértices (algoritmo de Dijkstra).
+ *
+ * O caminho é calculado sobre uma cópia compacta do grafo (ver CaminhoPesoMinimoCompacto). Para várias pesquisas
+ * sobre o mesmo grafo deve ser criada uma só cópia compacta e usada CaminhoPesoMinimoCompacto.
+ *
+ * @param g O apontador para o grafo.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Caminho encontrado.
+ *        -  0: Não há caminho entre os dois vértices.
+ *        - -1: Um ou ambos os vértices não existem no grafo.
+ *        - -2: O grafo tem uma aresta de peso negativo.
+ *        - -3: Falta de memória.
+ * @return Retorna um apontador para o resultado (peso em "soma" e vértices em "percurso"), a destruir com
+ *         DestruirResultado, ou NULL se não houver caminho.
+ */
+Resultado* CaminhoPesoMinimo(Grafo* g, IdVertice idOrigem, IdVertice idDestino, int* res) {
+	*res = -1;
+	if (!ExisteVerticeGrafo(g, idOrigem) || !ExisteVerticeGrafo(g, idDestino)) return NULL;
+	*res = -3;
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	if (gc == NULL) return NULL;
+	Resultado* caminho = CaminhoPesoMinimoCompacto(gc, idOrigem, idDestino, res);
+	DestruirGrafoCompacto(gc);
+	return caminho;
+}
+
+#pragma endregion
+
+#pragma region CaminhoPesoMaximoAciclico
+
+/**
+ * @brief Calcula o caminho de maior peso entre dois vértices de um grafo acíclico.
+ *
+ * Em grafos sem ciclos o caminho de maior peso calcula-se por programação dinâmica, percorrendo os vértices
+ * por ordem topológica (obtida com ComponentesFortementeLigadas: num grafo acíclico cada vértice é uma componente).
+ * A pesquisa termina quando chega ao destino, porque os vértices seguintes na ordem topológica não o alcançam.
+ * Os pesos podem ser negativos.
+ *
+ * @param g O apontador para o grafo.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Caminho encontrado.
+ *        -  0: Não há caminho entre os dois vértices.
+ *        - -1: Um ou ambos os vértices não existem no grafo.
+ *        - -2: O grafo tem ciclos.
+ *        - -3: Falta de memória.
+ * @return Retorna um apontador para o resultado (peso em "soma" e vértices em "percurso"), a destruir com
+ *         DestruirResultado, ou NULL se não houver caminho.
+ */
+Resultado* CaminhoPesoMaximoAciclico(Grafo* g, IdVertice idOrigem, IdVertice idDestino, int* res) {
+	*res = -1;
+	int origem = IndiceVerticeGrafo(g, idOrigem);
+	int destino = IndiceVerticeGrafo(g, idDestino);
+	if (origem < 0 || destino < 0) return NULL;
+	*res = -3;
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	if (gc == NULL) return NULL;
+	int n = gc->numVertices;
+	int total = 0;
+	int* componente = ComponentesFortementeLigadas(gc, &total);
+	int* ordem = (int*)malloc((n + 1) * sizeof(int)); // Vértice de cada posição da ordem topológica
+	TipoSoma* peso = (TipoSoma*)malloc((n + 1) * sizeof(TipoSoma));
+	int* anterior = (int*)malloc((n + 1) * sizeof(int));
+	Resultado* caminho = NULL;
+	if (componente != NULL && ordem != NULL && peso != NULL && anterior != NULL) {
+		bool aciclico = total == n;
+		for (int v = 0; v < n && aciclico; v++) {
+			for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+				if (gc->destinos[k] == v) aciclico = false; // Um lacete também é um ciclo
+			}
+		}
+		if (!aciclico) *res = -2;
+		else {
+			for (int v = 0; v < n; v++) {
+				ordem[componente[v]] = v;
+				peso[v] = SOMA_MIN; // Ainda não alcançado a partir da origem
+				anterior[v] = -1;
+			}
+			peso[origem] = 0;
+			// Os vértices anteriores à origem na ordem topológica não são alcançáveis a partir dela
+			for (int i = componente[origem]; i <= componente[destino]; i++) {
+				int v = ordem[i];
+				if (peso[v] == SOMA_MIN) continue;
+				if (v == destino) break;
+				for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+					int w = gc->destinos[k];
+					TipoSoma novo = peso[v] + gc->valores[v] + gc->valores[w];
+					if (novo > peso[w]) {
+						peso[w] = novo;
+						anterior[w] = v;
+					}
+				}
+			}
+			*res = 0;
+			if (peso[destino] != SOMA_MIN) {
+				caminho = CriarResultadoCaminho(gc, anterior, destino, peso[destino]);
+				*res = caminho != NULL ? 1 : -3;
+			}
+		}
+	}
+	free(componente);
+	free(ordem);
+	free(peso);
+	free(anterior);
+	DestruirGrafoCompacto(gc);
+	return caminho;
+}
+
+#pragma endregion
+
+#pragma endregion
@@ -0,0 +1,226 @@
+/*********************************************************************
+ * @file   enumeracao.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region ENUMERACAO
+
+#pragma region Auxiliares
+
+/**
+ * Acrescenta um vértice ao caminho atual.
+ */
+static void Empilhar(EnumeradorCaminhos* e, int v) {
+	int d = e->profundidade++;
+	e->pilha[d] = v;
+	e->proximaAresta[d] = e->gc->inicioAdj[v];
+	e->somas[d] = (d > 0 ? e->somas[d - 1] : 0) + e->gc->valores[v];
+	e->percurso[d] = e->gc->ids[v];
+	e->noCaminho[v] = true;
+}
+
+/**
+ * Retira o último vértice do caminho atual.
+ */
+static void Desempilhar(EnumeradorCaminhos* e) {
+	e->noCaminho[e->pilha[--e->profundidade]] = false;
+}
+
+/**
+ * Verifica se o caminho atual deve ser entregue ao consumidor.
+ */
+static bool AceitarCaminho(EnumeradorCaminhos* e) {
+	int v = e->pilha[e->profundidade - 1];
+	if (!e->opcoes.qualquerDestino && v != e->destino) return false;
+	return e->somas[e->profundidade - 1] >= e->opcoes.somaMinima;
+}
+
+#pragma endregion
+
+#pragma region CriarEnumeradorCaminhos
+
+/**
+ * @brief Prepara um enumerador para uma nova enumeração, sem alocar memória.
+ *
+ * @param e O apontador para o enumerador.
+ * @param idOrigem O identificador do vértice de origem (ignorado se `opcoes->qualquerOrigem`).
+ * @param idDestino O identificador do vértice de destino (ignorado se `opcoes->qualquerDestino`).
+ * @param opcoes As opções da enumeração (NULL para enumerar todos os caminhos da origem ao destino, sem limites).
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Enumerador preparado.
+ *        - -1: O enumerador é nulo ou a origem ou o destino não existem no grafo.
+ * @return `true` se o enumerador foi preparado, caso contrário `false`.
+ */
+bool ReiniciarEnumeradorCaminhos(EnumeradorCaminhos* e, IdVertice idOrigem, IdVertice idDestino, OpcoesEnumeracao* opcoes, int* res) {
+	*res = -1;
+	if (e == NULL) return false;
+	OpcoesEnumeracao porOmissao = { false, false, SOMA_MIN, 0 };
+	e->opcoes = opcoes != NULL ? *opcoes : porOmissao;
+	if (e->opcoes.maxVertices <= 0 || e->opcoes.maxVertices > e->gc->numVertices) e->opcoes.maxVertices = e->gc->numVertices;
+	e->origem = e->opcoes.qualquerOrigem ? 0 : IndiceGrafoCompacto(e->gc, idOrigem);
+	e->destino = e->opcoes.qualquerDestino ? -1 : IndiceGrafoCompacto(e->gc, idDestino);
+	while (e->profundidade > 0) Desempilhar(e);
+	e->entregues = 0;
+	e->terminado = true;
+	if (e->origem < 0 || (!e->opcoes.qualquerDestino && e->destino < 0)) return false;
+	e->terminado = false;
+	*res = 1;
+	return true;
+}
+
+/**
+ * @brief Cria um enumerador dos caminhos simples de um grafo compacto.
+ *
+ * Os caminhos são produzidos um de cada vez, por uma pesquisa em profundidade que fica suspensa entre pedidos,
+ * pelo que o consumidor só paga pelos caminhos que pede. Toda a memória é alocada aqui: a enumeração em si não
+ * aloca nada, e o enumerador pode ser reutilizado para outras enumerações com ReiniciarEnumeradorCaminhos.
+ *
+ * @param gc O apontador para o grafo compacto (não pode ser destruído enquanto o enumerador for usado).
+ * @param idOrigem O identificador do vértice de origem (ignorado se `opcoes->qualquerOrigem`).
+ * @param idDestino O identificador do vértice de destino (ignorado se `opcoes->qualquerDestino`).
+ * @param opcoes As opções da enumeração (NULL para enumerar todos os caminhos da origem ao destino, sem limites).
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Enumerador criado.
+ *        - -1: O grafo é nulo ou a origem ou o destino não existem no grafo.
+ *        - -3: Falta de memória.
+ * @return Retorna um apontador para o enumerador, a destruir com DestruirEnumeradorCaminhos, ou NULL em caso de erro.
+ */
+EnumeradorCaminhos* CriarEnumeradorCaminhos(GrafoCompacto* gc, IdVertice idOrigem, IdVertice idDestino, OpcoesEnumeracao* opcoes, int* res) {
+	*res = -1;
+	if (gc == NULL) return NULL;
+	*res = -3;
+	EnumeradorCaminhos* e = (EnumeradorCaminhos*)calloc(1, sizeof(EnumeradorCaminhos));
+	if (e == NULL) return NULL;
+	int n = gc->numVertices;
+	e->gc = gc;
+	e->pilha = (int*)malloc((n + 1) * sizeof(int));
+	e->proximaAresta = (int*)malloc((n + 1) * sizeof(int));
+	e->somas = (TipoSoma*)malloc((n + 1) * sizeof(TipoSoma));
+	e->noCaminho = (bool*)calloc(n + 1, sizeof(bool));
+	e->percurso = (IdVertice*)malloc((n + 1) * sizeof(IdVertice));
+	if (e->pilha == NULL || e->proximaAresta == NULL || e->somas == NULL || e->noCaminho == NULL || e->percurso == NULL) {
+		DestruirEnumeradorCaminhos(e);
+		return NULL;
+	}
+	if (!ReiniciarEnumeradorCaminhos(e, idOrigem, idDestino, opcoes, res)) {
+		DestruirEnumeradorCaminhos(e);
+		return NULL;
+	}
+	return e;
+}
+
+#pragma endregion
+
+#pragma region ProximoCaminho
+
+/**
+ * @brief Avança a enumeração até ao próximo caminho que cumpra as opções.
+ *
+ * O vetor entregue em `percurso` pertence ao enumerador e só é válido até ao pedido seguinte.
+ * Um caminho que termina no destino não é prolongado (voltaria a passar pelo destino).
+ *
+ * @param e O apontador para o enumerador.
+ * @param percurso Apontador onde é guardado o endereço dos identificadores dos vértices do caminho.
+ * @param tamanho Apontador onde é guardado o número de vértices do caminho.
+ * @param soma Apontador onde é guardada a soma dos valores dos vértices do caminho.
+ * @return `true` se foi encontrado um caminho, `false` se a enumeração terminou.
+ */
+bool ProximoCaminho(EnumeradorCaminhos* e, const IdVertice** percurso, int* tamanho, TipoSoma* soma) {
+	if (e == NULL) return false;
+	GrafoCompacto* gc = e->gc;
+	while (!e->terminado) {
+		if (e->profundidade == 0) {
+			// Começar os caminhos do próximo vértice de partida
+			if (e->origem >= gc->numVertices || e->origem < 0) {
+				e->terminado = true;
+				break;
+			}
+			Empilhar(e, e->origem);
+			e->origem = e->opcoes.qualquerOrigem ? e->origem + 1 : -1; // Com uma origem fixa, não há mais partidas
+		}
+		else {
+			// Prolongar o caminho atual pela próxima aresta para um vértice livre, ou recuar
+			int d = e->profundidade - 1;
+			int v = e->pilha[d];
+			int k = e->proximaAresta[d];
+			bool prolongar = e->profundidade < e->opcoes.maxVertices && v != e->destino;
+			if (prolongar) {
+				while (k < gc->inicioAdj[v + 1] && e->noCaminho[gc->destinos[k]]) k++;
+			}
+			if (!prolongar || k >= gc->inicioAdj[v + 1]) {
+				Desempilhar(e);
+				continue;
+			}
+			e->proximaAresta[d] = k + 1;
+			Empilhar(e, gc->destinos[k]);
+		}
+		if (AceitarCaminho(e)) {
+			*percurso = e->percurso;
+			*tamanho = e->profundidade;
+			*soma = e->somas[e->profundidade - 1];
+			e->entregues++;
+			return true;
+		}
+	}
+	*percurso = NULL;
+	*tamanho = 0;
+	return false;
+}
+
+#pragma endregion
+
+#pragma region EnumerarCaminhos
+
+/**
+ * @brief Entrega os caminhos restantes da enumeração, um de cada vez, a uma função.
+ *
+ * A enumeração termina quando não houver mais caminhos ou quando a função devolver `false`; neste caso pode ser
+ * retomada mais tarde com ProximoCaminho ou com outra chamada a EnumerarCaminhos.
+ *
+ * @param e O apontador para o enumerador.
+ * @param visitar A função chamada para cada caminho (o vetor do percurso só é válido durante a chamada).
+ * @param contexto O contexto entregue à função.
+ * @return O número de caminhos entregues à função.
+ */
+long EnumerarCaminhos(EnumeradorCaminhos* e, VisitarCaminho visitar, void* contexto) {
+	if (e == NULL || visitar == NULL) return 0;
+	long entregues = 0;
+	const IdVertice* percurso;
+	int tamanho;
+	TipoSoma soma;
+	while (ProximoCaminho(e, &percurso, &tamanho, &soma)) {
+		entregues++;
+		if (!visitar(percurso, tamanho, soma, contexto)) break;
+	}
+	return entregues;
+}
+
+#pragma endregion
+
+#pragma region DestruirEnumeradorCaminhos
+
+/**
+ * @brief Liberta a memória associada a um enumerador de caminhos.
+ *
+ * O grafo compacto não é alterado.
+ *
+ * @param e O apontador para o enumerador a destruir.
+ */
+void DestruirEnumeradorCaminhos(EnumeradorCaminhos* e) {
+	if (e == NULL) return;
+	free(e->pilha);
+	free(e->proximaAresta);
+	free(e->somas);
+	free(e->noCaminho);
+	free(e->percurso);
+	free(e);
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
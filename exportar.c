@@ -0,0 +1,406 @@
+/*********************************************************************
+ * @file   exportar.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#define _POSIX_C_SOURCE 200809L // fileno
+#include "header.h"
+#ifdef _MSC_VER
+#include <io.h>
+#define EscreverDescritor(fd, dados, n) _write((fd), (dados), (unsigned int)(n))
+#else
+#include <unistd.h>
+#define EscreverDescritor(fd, dados, n) write((fd), (dados), (n))
+#endif
+
+#define TAM_BUFFER_EXPORTACAO (1 << 20) // Tamanho do buffer de uma saída para um descritor (bytes)
+#define TAM_BUFFER_MEMORIA 4096 // Capacidade inicial de uma saída para memória (bytes)
+#define MAX_DIGITOS_INTEIRO 24 // Número máximo de caracteres de um inteiro de 64 bits com sinal
+#define SEPARADOR_TEXTO "-----------------------------------------------------------------------"
+
+// Garante que o buffer tem espaço para mais n bytes (o caso comum, em que já tem, não chama nenhuma função)
+#define ReservarSaida(s, n) ((s)->usados + (n) < (s)->capacidade || AumentarSaida((s), (n)))
+
+// Escreve um texto constante (o tamanho é calculado na compilação)
+#define EscreverLiteral(s, texto) EscreverBytes((s), (texto), sizeof(texto) - 1)
+
+#pragma region EXPORTAR
+
+#pragma region Auxiliares
+
+/**
+ * Arranja espaço no buffer para mais `n` bytes, quando o espaço livre não chega: numa saída para um descritor escreve
+ * o que já está no buffer; numa saída para memória aumenta o buffer (fica sempre um byte livre para o terminador).
+ */
+static bool AumentarSaida(SaidaExportacao* s, size_t n) {
+	if (s->descritor >= 0) {
+		if (!DescarregarSaida(s)) return false;
+		if (n < s->capacidade) return true;
+	}
+	size_t capacidade = s->capacidade * 2;
+	while (s->usados + n >= capacidade) capacidade *= 2;
+	char* aux = (char*)realloc(s->buffer, capacidade);
+	if (aux == NULL) {
+		s->erro = true;
+		return false;
+	}
+	s->buffer = aux;
+	s->capacidade = capacidade;
+	return true;
+}
+
+/**
+ * Acrescenta `n` bytes à saída.
+ */
+static void EscreverBytes(SaidaExportacao* s, const char* dados, size_t n) {
+	if (!ReservarSaida(s, n)) return;
+	memcpy(s->buffer + s->usados, dados, n);
+	s->usados += n;
+}
+
+/**
+ * Acrescenta um inteiro em decimal à saída, sem passar pelo printf (os algarismos são escritos do fim para o início).
+ */
+static void EscreverInteiro(SaidaExportacao* s, long long valor) {
+	static const char pares[] =
+		"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+		"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+	if (!ReservarSaida(s, MAX_DIGITOS_INTEIRO)) return;
+	char digitos[MAX_DIGITOS_INTEIRO];
+	int i = MAX_DIGITOS_INTEIRO;
+	unsigned long long x = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+	while (x >= 100) { // Dois algarismos por divisão
+		int par = (int)(x % 100) * 2;
+		x /= 100;
+		digitos[--i] = pares[par + 1];
+		digitos[--i] = pares[par];
+	}
+	if (x >= 10) {
+		digitos[--i] = pares[x * 2 + 1];
+		digitos[--i] = pares[x * 2];
+	}
+	else digitos[--i] = (char)('0' + x);
+	if (valor < 0) digitos[--i] = '-';
+	memcpy(s->buffer + s->usados, digitos + i, MAX_DIGITOS_INTEIRO - i);
+	s->usados += MAX_DIGITOS_INTEIRO - i;
+}
+
+/**
+ * Acrescenta um carácter à saída.
+ */
+static void EscreverCaracter(SaidaExportacao* s, char c) {
+	if (!ReservarSaida(s, 1)) return;
+	s->buffer[s->usados++] = c;
+}
+
+/**
+ * Obtém o vértice de destino de uma adjacência: pela tabela de identificadores do grafo, se existir, ou pela tabela
+ * temporária criada sobre a lista de vértices.
+ */
+static Vertice* DestinoAdjacente(Grafo* g, TabelaIds* ids, Vertice** vertices, IdVertice id) {
+	if (g != NULL) return OndeEstaVerticeGrafo(g, id);
+	int i = ObterIndiceTabelaIds(ids, id);
+	return i >= 0 ? vertices[i] : NULL;
+}
+
+/**
+ * Escreve a lista de adjacências no formato de MostrarGrafo.
+ */
+static void EscreverTexto(SaidaExportacao* s, Vertice* inicio, Grafo* g, TabelaIds* ids, Vertice** vertices) {
+	EscreverLiteral(s, SEPARADOR_TEXTO);
+	for (Vertice* v = inicio; v != NULL && !s->erro; v = v->proxVertice) {
+		EscreverLiteral(s, "\nVertice ");
+		EscreverInteiro(s, v->id);
+		EscreverLiteral(s, ": ");
+		EscreverInteiro(s, v->valor);
+		EscreverLiteral(s, "\t\n\n\tAdjacentes:\t");
+		for (int i = 0; i < v->numAdjacentes; i++) {
+			Vertice* w = DestinoAdjacente(g, ids, vertices, v->adjacentes[i]);
+			if (w == NULL) continue;
+			EscreverLiteral(s, "Vertice ");
+			EscreverInteiro(s, w->id);
+			EscreverLiteral(s, ":\t");
+			EscreverInteiro(s, w->valor);
+			EscreverLiteral(s, "\t(Soma:");
+			EscreverInteiro(s, PesoAdjacente(v, w));
+			EscreverLiteral(s, ")\n\t\t\t");
+		}
+		EscreverLiteral(s, "\n" SEPARADOR_TEXTO "\n");
+	}
+}
+
+/**
+ * Escreve a lista de arestas em CSV, com uma linha de cabeçalho.
+ */
+static void EscreverCsv(SaidaExportacao* s, Grafo* g) {
+	EscreverLiteral(s, "origem,destino,valor_origem,valor_destino,peso\n");
+	for (Vertice* v = g->inicioGrafo; v != NULL && !s->erro; v = v->proxVertice) {
+		for (int i = 0; i < v->numAdjacentes; i++) {
+			Vertice* w = OndeEstaVerticeGrafo(g, v->adjacentes[i]);
+			if (w == NULL) continue;
+			EscreverInteiro(s, v->id);
+			EscreverCaracter(s, ',');
+			EscreverInteiro(s, w->id);
+			EscreverCaracter(s, ',');
+			EscreverInteiro(s, v->valor);
+			EscreverCaracter(s, ',');
+			EscreverInteiro(s, w->valor);
+			EscreverCaracter(s, ',');
+			EscreverInteiro(s, PesoAdjacente(v, w));
+			EscreverCaracter(s, '\n');
+		}
+	}
+}
+
+/**
+ * Escreve o grafo no formato DOT do Graphviz: cada vértice com o seu valor e cada aresta com o seu peso.
+ */
+static void EscreverDot(SaidaExportacao* s, Grafo* g) {
+	EscreverLiteral(s, "digraph Grafo {\n");
+	for (Vertice* v = g->inicioGrafo; v != NULL && !s->erro; v = v->proxVertice) {
+		EscreverCaracter(s, '\t');
+		EscreverInteiro(s, v->id);
+		EscreverLiteral(s, " [label=\"");
+		EscreverInteiro(s, v->id);
+		EscreverLiteral(s, ": ");
+		EscreverInteiro(s, v->valor);
+		EscreverLiteral(s, "\"];\n");
+	}
+	for (Vertice* v = g->inicioGrafo; v != NULL && !s->erro; v = v->proxVertice) {
+		for (int i = 0; i < v->numAdjacentes; i++) {
+			Vertice* w = OndeEstaVerticeGrafo(g, v->adjacentes[i]);
+			if (w == NULL) continue;
+			EscreverCaracter(s, '\t');
+			EscreverInteiro(s, v->id);
+			EscreverLiteral(s, " -> ");
+			EscreverInteiro(s, w->id);
+			EscreverLiteral(s, " [label=\"");
+			EscreverInteiro(s, PesoAdjacente(v, w));
+			EscreverLiteral(s, "\"];\n");
+		}
+	}
+	EscreverLiteral(s, "}\n");
+}
+
+/**
+ * Cria uma saída com um buffer da capacidade indicada.
+ */
+static SaidaExportacao* CriarSaida(int descritor, size_t capacidade) {
+	SaidaExportacao* s = (SaidaExportacao*)calloc(1, sizeof(SaidaExportacao));
+	if (s == NULL) return NULL;
+	s->buffer = (char*)malloc(capacidade);
+	if (s->buffer == NULL) {
+		free(s);
+		return NULL;
+	}
+	s->capacidade = capacidade;
+	s->descritor = descritor;
+	return s;
+}
+
+#pragma endregion
+
+#pragma region CriarSaidaExportacao
+
+/**
+ * @brief Cria uma saída que escreve num descritor de ficheiro (ficheiro, pipe ou socket já abertos).
+ *
+ * Os dados são acumulados num buffer de TAM_BUFFER_EXPORTACAO bytes e escritos em blocos, com uma chamada ao sistema
+ * por bloco. O descritor não é fechado por DestruirSaidaExportacao.
+ *
+ * @param descritor O descritor de ficheiro.
+ * @return Apontador para a saída, ou NULL se o descritor for inválido ou se a alocação de memória falhar.
+ */
+SaidaExportacao* CriarSaidaDescritor(int descritor) {
+	if (descritor < 0) return NULL;
+	return CriarSaida(descritor, TAM_BUFFER_EXPORTACAO);
+}
+
+/**
+ * @brief Cria uma saída para a saída padrão (stdout).
+ *
+ * O que já estiver no buffer do stdio é escrito antes de cada bloco, para que a ordem do texto se mantenha
+ * quando a saída é misturada com printf.
+ *
+ * @return Apontador para a saída, ou NULL se a alocação de memória falhar.
+ */
+SaidaExportacao* CriarSaidaPadrao() {
+	SaidaExportacao* s = CriarSaida(fileno(stdout), TAM_BUFFER_EXPORTACAO);
+	if (s != NULL) s->saidaPadrao = true;
+	return s;
+}
+
+/**
+ * @brief Cria uma saída que guarda os dados em memória (obtidos com ConteudoSaida).
+ *
+ * @return Apontador para a saída, ou NULL se a alocação de memória falhar.
+ */
+SaidaExportacao* CriarSaidaMemoria() {
+	return CriarSaida(-1, TAM_BUFFER_MEMORIA);
+}
+
+#pragma endregion
+
+#pragma region ExportarGrafo
+
+/**
+ * @brief Exporta um grafo para uma saída, num dos formatos de FormatoExportacao.
+ *
+ * Os números são formatados à mão diretamente no buffer da saída e os vértices de destino são obtidos pela tabela
+ * de identificadores, pelo que o custo é linear no número de vértices e de arestas.
+ *
+ * @param s O apontador para a saída.
+ * @param g O apontador para o grafo.
+ * @param formato O formato: lista de adjacências (o texto de MostrarGrafo), lista de arestas em CSV ou DOT do Graphviz.
+ * @return `true` se o grafo foi exportado, `false` se os argumentos forem nulos ou se uma escrita ou alocação falhar.
+ */
+bool ExportarGrafo(SaidaExportacao* s, Grafo* g, FormatoExportacao formato) {
+	if (s == NULL || g == NULL) return false;
+	RASTREIO_INICIO(inicio);
+	if (formato == EXPORTAR_CSV) EscreverCsv(s, g);
+	else if (formato == EXPORTAR_DOT) EscreverDot(s, g);
+	else EscreverTexto(s, g->inicioGrafo, g, NULL, NULL);
+	RASTREIO_FIM(inicio, "ExportarGrafo");
+	return !s->erro;
+}
+
+/**
+ * @brief Exporta uma lista de vértices para uma saída, no formato de texto de MostrarGrafo.
+ *
+ * Como não há grafo, é criada com IndexarVertices uma tabela temporária de identificadores para os vértices da lista,
+ * pelo que o destino de cada adjacência é obtido em tempo constante e o custo é linear no número de vértices e de
+ * arestas.
+ *
+ * @param s O apontador para a saída.
+ * @param inicio Apontador para o vértice inicial da lista.
+ * @return `true` se a lista foi exportada, `false` se a saída for nula ou se uma escrita ou alocação falhar.
+ */
+bool ExportarVertices(SaidaExportacao* s, Vertice* inicio) {
+	if (s == NULL) return false;
+	TabelaIds ids;
+	Vertice** vertices = IndexarVertices(inicio, &ids, NULL);
+	if (vertices == NULL) {
+		s->erro = true;
+		return false;
+	}
+	EscreverTexto(s, inicio, NULL, &ids, vertices);
+	DestruirTabelaIds(&ids);
+	free(vertices);
+	return !s->erro;
+}
+
+#pragma endregion
+
+#pragma region ExportarResultado
+
+/**
+ * @brief Exporta um resultado (soma e caminho) para uma saída, no formato de MostrarSomaMaxima.
+ *
+ * Se o resultado tiver o percurso, são escritos os vértices do percurso; caso contrário são escritos os vértices
+ * da lista a partir do vértice guardado no resultado.
+ *
+ * @param s O apontador para a saída.
+ * @param r O apontador para o resultado.
+ * @return `true` se o resultado foi exportado, `false` se os argumentos forem nulos ou se uma escrita ou alocação falhar.
+ */
+bool ExportarResultado(SaidaExportacao* s, Resultado* r) {
+	if (s == NULL || r == NULL) return false;
+	EscreverLiteral(s, "Soma Maxima: ");
+	EscreverInteiro(s, r->soma);
+	EscreverLiteral(s, "\nCaminho: ");
+	if (r->percurso != NULL) {
+		for (int i = 0; i < r->tamanho; i++) {
+			EscreverInteiro(s, r->percurso[i]);
+			Vertice* v = r->grafo != NULL ? OndeEstaVerticeGrafo(r->grafo, r->percurso[i]) : NULL;
+			if (v != NULL) {
+				EscreverCaracter(s, '(');
+				EscreverInteiro(s, v->valor);
+				EscreverCaracter(s, ')');
+			}
+			EscreverCaracter(s, '\t');
+		}
+	}
+	else {
+		for (Vertice* v = r->caminho; v != NULL; v = v->proxVertice) {
+			EscreverInteiro(s, v->id);
+			EscreverCaracter(s, '(');
+			EscreverInteiro(s, v->valor);
+			EscreverLiteral(s, ")\t");
+		}
+	}
+	EscreverCaracter(s, '\n');
+	return !s->erro;
+}
+
+#pragma endregion
+
+#pragma region DescarregarSaida
+
+/**
+ * @brief Escreve no descritor os dados que estão no buffer de uma saída (numa saída para memória não faz nada).
+ *
+ * @param s O apontador para a saída.
+ * @return `true` se todos os dados foram escritos, `false` se a saída for nula ou se uma escrita falhar.
+ */
+bool DescarregarSaida(SaidaExportacao* s) {
+	if (s == NULL) return false;
+	if (s->descritor < 0 || s->erro) return !s->erro;
+	if (s->saidaPadrao) fflush(stdout);
+	size_t escritos = 0;
+	while (escritos < s->usados) {
+		long n = (long)EscreverDescritor(s->descritor, s->buffer + escritos, s->usados - escritos);
+		if (n <= 0) {
+			s->erro = true;
+			return false;
+		}
+		escritos += (size_t)n;
+	}
+	s->totalEscritos += (long long)s->usados;
+	s->usados = 0;
+	return true;
+}
+
+#pragma endregion
+
+#pragma region ConteudoSaida
+
+/**
+ * @brief Obtém os dados de uma saída para memória.
+ *
+ * @param s O apontador para a saída.
+ * @param tamanho Apontador para uma variável que recebe o número de bytes (pode ser NULL).
+ * @return Os dados, terminados por '\0' e válidos até à próxima escrita ou até a saída ser destruída, ou NULL se a
+ *         saída for nula ou escrever num descritor.
+ */
+const char* ConteudoSaida(SaidaExportacao* s, size_t* tamanho) {
+	if (s == NULL || s->descritor >= 0) return NULL;
+	s->buffer[s->usados] = '\0';
+	if (tamanho != NULL) *tamanho = s->usados;
+	return s->buffer;
+}
+
+#pragma endregion
+
+#pragma region DestruirSaidaExportacao
+
+/**
+ * @brief Escreve os dados que ficaram no buffer (se o destino for um descritor) e liberta a saída.
+ *
+ * @param s O apontador para a saída.
+ * @return `true` se todos os dados foram escritos, `false` se alguma escrita ou alocação tiver falhado.
+ */
+bool DestruirSaidaExportacao(SaidaExportacao* s) {
+	if (s == NULL) return false;
+	bool ok = DescarregarSaida(s);
+	free(s->buffer);
+	free(s);
+	return ok;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
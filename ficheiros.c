@@ -7,46 +7,140 @@
  * @date   May 2024
  *********************************************************************/
 #include "header.h"
+#include <errno.h>
+
+#define MAX_DIGITOS 32 // Número máximo de caracteres de um valor da matriz
 
 #pragma region FICHEIROS
 
 #pragma region LerMatrizDeFicheiro
 
- //Grafo* LerMatrizDeFicheiro(char* nomeFicheiro, int* res) {
- //	*res = 1;
- //	FILE* fp = fopen(nomeFicheiro, "r");
- //	if (fp == NULL) return NULL;
- //	int linhas = 0;
- //	int colunas = 0;
- //	char buffer[1024];
- //	while (fgets(buffer, sizeof(buffer), fp)) {
- //		if (linhas = 0) {
- //			char* aux = strdup(buffer);
- //			char* token = strtok(aux, ";");
- //			while (aux != NULL) {
- //				colunas++;
- //				token = strtok(NULL, ";");
- //			}
- //			free(aux);
- //		}
- //		linhas++;
- //	}
- //	rewind(fp);
- //	Grafo* g = CriarGrafo(linhas);
- //	int idVertice = 0;
- //	while (fgets(buffer, sizeof(buffer), fp)) {
- //		Vertice* v = CriarVertice(idVertice++);
- //		int idAdj = 0;
- //		char* token = strtok(buffer, ";");
- //		while (token != NULL) {
- //			int valor = atoi(token);
- //			v->proxAdjacente = InserirAdjGrafo(v->proxAdjacente, idAdj++, valor, res);
- //		}
- //		g = InserirVerticeGrafo(g, v, res);
- //	}
- //	fclose(fp);
- //	return g;
- //}
+ /**
+  * @brief Lê uma matriz de inteiros de um ficheiro de texto e cria o grafo correspondente.
+  *
+  * Cada linha do ficheiro é uma linha da matriz, com os valores separados por ';' (as linhas vazias são ignoradas).
+  * Cada elemento da matriz passa a ser um vértice, com identificadores atribuídos por linhas a partir de 1
+  * (o elemento da linha `i` e coluna `j`, a contar de 0, tem o identificador `i * colunas + j + 1`), e cada vértice
+  * tem uma aresta para o vértice à sua direita e outra para o vértice abaixo. A disposição em matriz fica guardada no
+  * grafo, para as operações sobre linhas e colunas (InserirLinhaGrelha, EliminarColunaGrelha, ...). O ficheiro é lido carácter a carácter,
+  * pelo que as linhas podem ter qualquer comprimento.
+  *
+  * @param nomeFicheiro O caminho do ficheiro.
+  * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+  *        -  1: Matriz lida com sucesso.
+  *        - -1: Não foi possível abrir o ficheiro.
+  *        - -2: Formato inválido (valor vazio ou que não é um número, que não cabe em TipoValor, ou linhas com números de colunas diferentes).
+  *        - -3: Falta de memória.
+  * @return Retorna um apontador para o grafo criado, ou NULL se a leitura falhar.
+  */
+Grafo* LerMatrizDeFicheiro(const char* nomeFicheiro, int* res) {
+	*res = -1;
+	FILE* fp = fopen(nomeFicheiro, "r");
+	if (fp == NULL) return NULL;
+	RASTREIO_INICIO(inicioLeitura);
+	TipoValor* valores = NULL;
+	int numValores = 0, capValores = 0;
+	int linhas = 0, colunas = 0, colunasLinha = 0;
+	char token[MAX_DIGITOS + 1];
+	int tamToken = 0;
+	bool conteudo = false; // Indica se o valor atual já tem algum carácter que não seja espaço
+	*res = 1;
+	int c;
+	do {
+		c = fgetc(fp);
+		if (c == ';' || c == '\n' || c == EOF) {
+			// Fim de um valor
+			if (conteudo || c == ';') { // Um separador no fim da linha não acrescenta uma coluna
+				token[tamToken] = '\0';
+				char* fim;
+				errno = 0;
+				long long valor = strtoll(token, &fim, 10);
+				bool semDigitos = fim == token; // Valor vazio ou só com espaços (por exemplo "1; ;3")
+				while (*fim == ' ' || *fim == '\t') fim++;
+				// ERANGE: o valor nem cabe em long long (strtoll satura em LLONG_MIN/LLONG_MAX)
+				if (!conteudo || semDigitos || *fim != '\0' || errno == ERANGE || valor < VALOR_MIN || valor > VALOR_MAX) {
+					*res = -2;
+					break;
+				}
+				if (numValores == capValores) {
+					int capacidade = capValores > 0 ? capValores * 2 : 64;
+					TipoValor* aux = (TipoValor*)realloc(valores, capacidade * sizeof(TipoValor));
+					if (aux == NULL) {
+						*res = -3;
+						break;
+					}
+					valores = aux;
+					capValores = capacidade;
+				}
+				valores[numValores++] = (TipoValor)valor;
+				colunasLinha++;
+			}
+			tamToken = 0;
+			conteudo = false;
+			// Fim de uma linha
+			if ((c == '\n' || c == EOF) && colunasLinha > 0) {
+				if (linhas == 0) colunas = colunasLinha;
+				else if (colunasLinha != colunas) {
+					*res = -2;
+					break;
+				}
+				linhas++;
+				colunasLinha = 0;
+			}
+		}
+		else if (c != '\r') {
+			if (c != ' ' && c != '\t') conteudo = true;
+			if (tamToken == MAX_DIGITOS) {
+				*res = -2;
+				break;
+			}
+			token[tamToken++] = (char)c;
+		}
+	} while (c != EOF);
+	fclose(fp);
+	RASTREIO_FIM(inicioLeitura, "LerMatrizDeFicheiro: ler valores");
+	RASTREIO_INICIO(inicioVertices);
+	Grafo* g = NULL;
+	if (*res == 1) {
+		g = CriarGrafo(linhas * colunas);
+		if (g == NULL) *res = -3;
+	}
+	// Os vértices são inseridos por ordem decrescente de identificador, ficando sempre no início da lista
+	for (int i = linhas * colunas - 1; i >= 0 && *res == 1; i--) {
+		Vertice* v = CriarVertice((IdVertice)i + 1, valores[i]);
+		if (v == NULL) *res = -3;
+		else {
+			g = InserirVerticeGrafo(g, v, res);
+			if (*res != 1) {
+				DestruirVertice(v);
+				*res = -3;
+			}
+		}
+	}
+	RASTREIO_FIM(inicioVertices, "LerMatrizDeFicheiro: inserir vertices");
+	RASTREIO_INICIO(inicioArestas);
+	// Arestas para a direita e para baixo
+	bool inserida = true;
+	for (int i = 0; i < linhas && *res == 1; i++) {
+		for (int j = 0; j < colunas && inserida; j++) {
+			IdVertice id = (IdVertice)i * colunas + j + 1;
+			if (j + 1 < colunas) g = InserirAdjGrafo(g, id, id + 1, &inserida);
+			if (i + 1 < linhas && inserida) g = InserirAdjGrafo(g, id, id + colunas, &inserida);
+		}
+		if (!inserida) *res = -3;
+	}
+	RASTREIO_FIM(inicioArestas, "LerMatrizDeFicheiro: inserir arestas");
+	free(valores);
+	if (*res == 1) { // Disposição em matriz, para as operações sobre linhas e colunas
+		g->grelha = CriarGrelha(linhas, colunas);
+		if (g->grelha == NULL) *res = -3;
+	}
+	if (*res != 1) {
+		DestruirGrafo(g);
+		return NULL;
+	}
+	return g;
+}
 
 #pragma endregion
 
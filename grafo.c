@@ -13,19 +13,31 @@
 #pragma region CriarGrafo
 
  /**
-  * Cria um novo grafo com o nmero total de vrtices especificado.
+  * Cria um novo grafo com o número total de vértices especificado.
   *
-  * Esta funo aloca memria para um novo grafo e inicializa suas variveis.
+  * Esta função aloca memória para um novo grafo e inicializa suas variáveis, incluindo a tabela
+  * que associa os identificadores dos vértices a índices densos (0 a numVertices - 1).
   *
-  * @param tot Nmero total de vrtices do grafo.
-  * @return Retorna um apontador para o novo grafo criado.
+  * @param tot Número total de vértices do grafo (usado como capacidade inicial da tabela de identificadores).
+  * @return Retorna um apontador para o novo grafo criado, ou NULL se a alocação de memória falhar.
   */
 Grafo* CriarGrafo(int tot) {
-	Grafo* g = (Grafo*)malloc(sizeof(Grafo)); // Aloca memria para criar o grafo
-	if (g != NULL) { // Inicializa todas as variveis do grafo
+	Grafo* g = (Grafo*)malloc(sizeof(Grafo)); // Aloca memória para criar o grafo
+	if (g != NULL) { // Inicializa todas as variáveis do grafo
 		g->inicioGrafo = NULL;
+		g->fimGrafo = NULL;
 		g->numVertices = 0;
 		g->totVertices = tot;
+		g->blocoVertices = NULL;
+		g->blocoAdjacentes = NULL;
+		g->grelha = NULL;
+		g->capIndices = tot > 0 ? tot : 1;
+		g->porIndice = (Vertice**)malloc(g->capIndices * sizeof(Vertice*)); // Mapa inverso dos índices densos
+		if (g->porIndice == NULL || !CriarTabelaIds(&g->ids, g->capIndices)) { // Tabela de identificadores para índices densos
+			free(g->porIndice);
+			free(g);
+			return NULL;
+		}
 	}
 	return g;
 }
@@ -35,22 +47,25 @@ Grafo* CriarGrafo(int tot) {
 #pragma region InserirVerticeGrafo
 
 /**
- * Insere um novo vrtice no grafo.
- * Esta funo insere um novo vrtice no grafo, desde que o vrtice seja vlido
- * e ainda no exista no grafo.
- *
- * @param g Apontador para o grafo onde o vrtice ser inserido.
- * @param v Apontador para o vrtice a ser inserido.
- * @param res Apontador para um inteiro onde ser armazenado o resultado da operao:
- *        - 1: Insero bem-sucedida.
- *        - 0: Vrtice invlido, a insero no foi realizada.
- *        - -1: O grafo  invlido, a insero no foi realizada.
- *        - -2: O vrtice j existe no grafo, a insero no foi realizada.
- * @return Retorna um apontador para o grafo atualizado aps a insero do vrtice.
+ * Insere um novo vértice no grafo.
+ * Esta função insere um novo vértice no grafo, desde que o vértice seja válido
+ * e ainda não exista no grafo. Um vértice com um identificador maior do que todos os outros é acrescentado
+ * ao fim da lista sem a percorrer. O vértice recebe o índice denso seguinte (numVertices),
+ * que fica registado na tabela de identificadores e no mapa inverso do grafo.
+ *
+ * @param g Apontador para o grafo onde o vértice será inserido.
+ * @param v Apontador para o vértice a ser inserido.
+ * @param res Apontador para um inteiro onde será armazenado o resultado da operação:
+ *        - 1: Inserção bem-sucedida.
+ *        - 0: Vértice inválido, a inserção não foi realizada.
+ *        - -1: O grafo é inválido, a inserção não foi realizada.
+ *        - -2: O vértice já existe no grafo, a inserção não foi realizada.
+ *        - -3: Falta de memória para registar o índice do vértice, a inserção não foi realizada.
+ * @return Retorna um apontador para o grafo atualizado após a inserção do vértice.
  */
 Grafo* InserirVerticeGrafo(Grafo* g, Vertice* v, int* res) {
 	*res = 1;
-	if (v == NULL) { // Vrtice invlido
+	if (v == NULL) { // Vértice inválido
 		*res = 0;
 		return g;
 	}
@@ -58,14 +73,41 @@ Grafo* InserirVerticeGrafo(Grafo* g, Vertice* v, int* res) {
 		*res = -1;
 		return NULL;
 	}
-	if (ExisteVerticeGrafo(g, v->id)) { // Verifica se o vrtice j existe
+	if (ExisteVerticeGrafo(g, v->id)) { // Verifica se o vértice já existe
 		*res = -2;
 		return g;
 	}
-	g->inicioGrafo = InserirVertice(g->inicioGrafo, v, res); // Chama a funo para inserir o vrtice no incio do grafo depois de todas as validaes
+	if (g->numVertices == g->capIndices) { // Aumenta o mapa inverso dos índices densos
+		Vertice** porIndice = (Vertice**)realloc(g->porIndice, g->capIndices * 2 * sizeof(Vertice*));
+		if (porIndice == NULL) {
+			*res = -3;
+			return g;
+		}
+		g->porIndice = porIndice;
+		g->capIndices *= 2;
+	}
+	if (!InserirTabelaIds(&g->ids, v->id, g->numVertices)) { // Regista o índice denso do vértice
+		*res = -3;
+		return g;
+	}
+	if (g->fimGrafo != NULL && v->id > g->fimGrafo->id) { // Maior identificador do grafo: fica no fim da lista, sem a percorrer
+		v->antVertice = g->fimGrafo;
+		v->proxVertice = NULL;
+		g->fimGrafo->proxVertice = v;
+		*res = 1;
+	}
+	else {
+		g->inicioGrafo = InserirVertice(g->inicioGrafo, v, res); // Chama a função para inserir o vértice no início do grafo depois de todas as validações
+	}
 	if (*res == true) {
+		if (v->proxVertice == NULL) g->fimGrafo = v;
+		v->indice = g->numVertices;
+		g->porIndice[g->numVertices] = v;
 		g->numVertices++;
 	}
+	else {
+		RemoverTabelaIds(&g->ids, v->id);
+	}
 	return g;
 }
 
@@ -74,27 +116,25 @@ Grafo* InserirVerticeGrafo(Grafo* g, Vertice* v, int* res) {
 #pragma region InserirAdjGrafo
 
 /**
- * Insere uma aresta entre dois vrtices no grafo.
+ * Insere uma aresta entre dois vértices no grafo.
  *
- * Esta funo insere uma aresta entre os vrtices de origem e destino no grafo, se eles existirem.
+ * Esta função insere uma aresta entre os vértices de origem e destino no grafo, se eles existirem.
  *
  * @param g Apontador para o grafo.
- * @param idOrigem Identificador do vrtice de origem.
- * @param idDestino Identificador do vrtice de destino.
- * @param res Apontador para uma varivel booleana que ser definida como verdadeira se a operao for bem-sucedida.
- * @return Retorna um apontador para o grafo atualizado ou NULL se o grafo for nulo ou se os vrtices no forem encontrados.
+ * @param idOrigem Identificador do vértice de origem.
+ * @param idDestino Identificador do vértice de destino.
+ * @param res Apontador para uma variável booleana que será definida como verdadeira se a operação for bem-sucedida.
+ * @return Retorna um apontador para o grafo atualizado ou NULL se o grafo for nulo ou se os vértices não forem encontrados.
  */
-Grafo* InserirAdjGrafo(Grafo* g, int idOrigem, int idDestino, bool* res) {
+Grafo* InserirAdjGrafo(Grafo* g, IdVertice idOrigem, IdVertice idDestino, bool* res) {
 	*res = false;
 	if (g == NULL) return NULL;
-	Vertice* vertOrigem = OndeEstaVerticeGrafo(g, idOrigem); // Chama a funo para procurar o vrtice de origem
+	Vertice* vertOrigem = OndeEstaVerticeGrafo(g, idOrigem); // Chama a função para procurar o vértice de origem
 	if (vertOrigem == NULL) return g;
-	Vertice* vertDestino = OndeEstaVerticeGrafo(g, idDestino); // Chama a funo para procurar o vrtice de destino
+	Vertice* vertDestino = OndeEstaVerticeGrafo(g, idDestino); // Chama a função para procurar o vértice de destino
 	if (!vertDestino) return g;
-	int valorAdj = vertDestino->valor; // Adiciona o valor ao adjacente
-	int peso = vertOrigem->valor + vertDestino->valor; // Calcula o peso de uma aresta (valor do "vertOrigem" + o valor do "vertDestino")
-	vertOrigem->proxAdjacente = InserirAdjacente(vertOrigem->proxAdjacente, idDestino, valorAdj, peso); // Chama a funo para adicionar um novo adjacente ao vrtice de origem
-	*res = true;
+	// O peso da aresta (valor do "vertOrigem" + o valor do "vertDestino") é calculado quando é preciso, com PesoAdjacente
+	InserirAdjacente(vertOrigem, idDestino, res); // Chama a função para adicionar um novo adjacente ao vértice de origem
 	return g;
 }
 
@@ -103,24 +143,51 @@ Grafo* InserirAdjGrafo(Grafo* g, int idOrigem, int idDestino, bool* res) {
 #pragma region EliminarAdjGrafo
 
 /**
- * @brief Elimina uma aresta entre dois vrtices em um grafo.
+ * @brief Elimina uma aresta entre dois vértices em um grafo.
  *
- * Esta funo elimina a aresta entre o vrtice de origem e o vrtice de destino no grafo fornecido.
+ * Esta função elimina a aresta entre o vértice de origem e o vértice de destino no grafo fornecido.
  *
  * @param g O apontador para o grafo.
- * @param idOrigem O identificador do vrtice de origem.
- * @param idDestino O identificador do vrtice de destino.
- * @param res Um apontador para uma varivel booleana que ser atualizada para true se a operao for bem-sucedida, false caso contrrio.
- * @return O apontador para o grafo aps a eliminao da aresta.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @param res Um apontador para uma variável booleana que será atualizada para true se a operação for bem-sucedida, false caso contrário.
+ * @return O apontador para o grafo após a eliminação da aresta.
  */
-Grafo* EliminarAdjGrafo(Grafo* g, int idOrigem, int idDestino, bool* res) {
+Grafo* EliminarAdjGrafo(Grafo* g, IdVertice idOrigem, IdVertice idDestino, bool* res) {
 	*res = false;
 	if (g == NULL) return NULL;
-	Vertice* vertOrigem = OndeEstaVerticeGrafo(g, idOrigem); // Chama a funo para procurar o vrtice de origem
+	Vertice* vertOrigem = OndeEstaVerticeGrafo(g, idOrigem); // Chama a função para procurar o vértice de origem
 	if (vertOrigem == NULL) return g;
-	Vertice* vertDestino = OndeEstaVerticeGrafo(g, idDestino); // Chama a funo para procurar o vrtice de destino
+	Vertice* vertDestino = OndeEstaVerticeGrafo(g, idDestino); // Chama a função para procurar o vértice de destino
 	if (!vertDestino) return g;
-	vertOrigem->proxAdjacente = EliminarAdjacente(vertOrigem->proxAdjacente, idDestino, res); // Chama a funo para eliminar o adjacente do vrtice de origem
+	EliminarAdjacente(vertOrigem, idDestino, res); // Chama a função para eliminar o adjacente do vértice de origem
+	return g;
+}
+
+#pragma endregion
+
+#pragma region AlterarValorVerticeGrafo
+
+/**
+ * @brief Altera o valor de um vértice do grafo.
+ *
+ * O vértice é encontrado pela tabela de identificadores, em tempo constante. Os pesos das arestas que entram e
+ * saem do vértice não precisam de ser atualizados, porque são sempre derivados dos valores atuais (PesoAdjacente).
+ * As cópias compactas do grafo (GrafoCompacto) já criadas não são alteradas.
+ *
+ * @param g O apontador para o grafo.
+ * @param idVertice O identificador do vértice.
+ * @param valor O novo valor do vértice.
+ * @param res Um apontador para uma variável booleana que será atualizada para true se a operação for bem-sucedida, false caso contrário.
+ * @return O apontador para o grafo.
+ */
+Grafo* AlterarValorVerticeGrafo(Grafo* g, IdVertice idVertice, TipoValor valor, bool* res) {
+	*res = false;
+	if (g == NULL) return NULL;
+	Vertice* v = OndeEstaVerticeGrafo(g, idVertice);
+	if (v == NULL) return g; // O vértice não existe
+	v->valor = valor;
+	*res = true;
 	return g;
 }
 
@@ -129,17 +196,18 @@ Grafo* EliminarAdjGrafo(Grafo* g, int idOrigem, int idDestino, bool* res) {
 #pragma region OndeEstaVerticeGrafo
 
 /**
- * @brief Encontra um vrtice em um grafo com base em seu identificador.
+ * @brief Encontra um vértice em um grafo com base em seu identificador.
  *
- * Esta funo procura e retorna um apontador para o vrtice com o identificador especificado no grafo fornecido.
+ * Esta função procura e retorna um apontador para o vértice com o identificador especificado no grafo fornecido.
+ * A procura é feita na tabela de identificadores, em tempo constante.
  *
  * @param g O apontador para o grafo.
- * @param idVertice O identificador do vrtice a ser encontrado.
- * @return Um apontador para o vrtice encontrado, ou NULL se o vrtice no for encontrado ou se o grafo for nulo.
+ * @param idVertice O identificador do vértice a ser encontrado.
+ * @return Um apontador para o vértice encontrado, ou NULL se o vértice não for encontrado ou se o grafo for nulo.
  */
-Vertice* OndeEstaVerticeGrafo(Grafo* g, int idVertice) {
+Vertice* OndeEstaVerticeGrafo(Grafo* g, IdVertice idVertice) {
 	if (g == NULL) return NULL;
-	return(ObterVertice(g->inicioGrafo, idVertice)); // Retorna a funo para obter o vrtice
+	return(VerticePorIndice(g, IndiceVerticeGrafo(g, idVertice))); // Retorna o vértice através do seu índice denso
 }
 
 #pragma endregion
@@ -147,17 +215,52 @@ Vertice* OndeEstaVerticeGrafo(Grafo* g, int idVertice) {
 #pragma region ExisteVerticeGrafo
 
 /**
- * @brief Verifica se um vrtice existe em um grafo com base em seu identificador.
+ * @brief Verifica se um vértice existe em um grafo com base em seu identificador.
  *
- * Esta funo verifica se um vrtice com o identificador especificado existe no grafo fornecido.
+ * Esta função verifica se um vértice com o identificador especificado existe no grafo fornecido.
  *
  * @param g O apontador para o grafo.
- * @param idVertice O identificador do vrtice a ser verificado.
- * @return true se o vrtice existir no grafo, false caso contrrio ou se o grafo for nulo.
+ * @param idVertice O identificador do vértice a ser verificado.
+ * @return true se o vértice existir no grafo, false caso contrário ou se o grafo for nulo.
  */
-bool ExisteVerticeGrafo(Grafo* g, int idVertice) {
-	if (g == NULL) return NULL;
-	return(ExisteVertice(g->inicioGrafo, idVertice)); // Retorna a funo para verificar se o vrtice existe
+bool ExisteVerticeGrafo(Grafo* g, IdVertice idVertice) {
+	if (g == NULL) return false;
+	return(IndiceVerticeGrafo(g, idVertice) >= 0); // Verifica se o identificador tem um índice denso atribuído
+}
+
+#pragma endregion
+
+#pragma region IndiceVerticeGrafo
+
+/**
+ * @brief Obtém o índice denso de um vértice a partir do seu identificador.
+ *
+ * Os índices densos vão de 0 a numVertices - 1 e servem para indexar os vetores auxiliares
+ * das pesquisas (visitados, somas, antecessores), seja qual for o identificador do vértice.
+ *
+ * @param g O apontador para o grafo.
+ * @param idVertice O identificador do vértice.
+ * @return O índice denso do vértice, ou -1 se o vértice não existir ou se o grafo for nulo.
+ */
+int IndiceVerticeGrafo(Grafo* g, IdVertice idVertice) {
+	if (g == NULL) return -1;
+	return(ObterIndiceTabelaIds(&g->ids, idVertice));
+}
+
+#pragma endregion
+
+#pragma region VerticePorIndice
+
+/**
+ * @brief Obtém o vértice com um determinado índice denso.
+ *
+ * @param g O apontador para o grafo.
+ * @param indice O índice denso do vértice.
+ * @return Um apontador para o vértice, ou NULL se o índice for inválido ou se o grafo for nulo.
+ */
+Vertice* VerticePorIndice(Grafo* g, int indice) {
+	if (g == NULL || indice < 0 || indice >= g->numVertices) return NULL;
+	return(g->porIndice[indice]);
 }
 
 #pragma endregion
@@ -165,19 +268,67 @@ bool ExisteVerticeGrafo(Grafo* g, int idVertice) {
 #pragma region EliminarVerticeGrafo
 
 /**
- * @brief Elimina um vrtice de um grafo com base em seu identificador.
+ * @brief Elimina um vértice de um grafo com base em seu identificador.
  *
- * Esta funo elimina o vrtice com o identificador especificado do grafo fornecido.
+ * Esta função elimina o vértice com o identificador especificado do grafo fornecido, em tempo constante (o vértice
+ * é encontrado pela tabela de identificadores e retirado da lista pelos seus vizinhos). Para manter os
+ * índices densos contíguos, o vértice com o último índice passa a ocupar o índice do vértice eliminado.
+ * As arestas de outros vértices para o vértice eliminado não são retiradas.
  *
  * @param g O apontador para o grafo.
- * @param idVertice O identificador do vrtice a ser eliminado.
- * @param res Um apontador para uma varivel booleana que ser atualizada para true se a operao for bem-sucedida, false caso contrrio.
- * @return O apontador para o grafo aps a eliminao do vrtice.
+ * @param idVertice O identificador do vértice a ser eliminado.
+ * @param res Um apontador para uma variável booleana que será atualizada para true se a operação for bem-sucedida, false caso contrário.
+ * @return O apontador para o grafo após a eliminação do vértice.
  */
-Grafo* EliminarVerticeGrafo(Grafo* g, int idVertice, bool* res) {
+Grafo* EliminarVerticeGrafo(Grafo* g, IdVertice idVertice, bool* res) {
 	*res = false;
 	if (g == NULL) return NULL;
-	g->inicioGrafo = EliminarVertice(g->inicioGrafo, idVertice, res); // Chama a funo para eliminar o vrtice
+	int indice = IndiceVerticeGrafo(g, idVertice);
+	if (indice < 0) return g; // O vértice não existe
+	// O vértice é retirado da lista pelos seus vizinhos, sem a percorrer
+	Vertice* v = g->porIndice[indice];
+	if (v->antVertice != NULL) v->antVertice->proxVertice = v->proxVertice;
+	else g->inicioGrafo = v->proxVertice;
+	if (v->proxVertice != NULL) v->proxVertice->antVertice = v->antVertice;
+	else g->fimGrafo = v->antVertice;
+	DestruirVertice(v); // Liberta também o vetor de adjacências do vértice
+	*res = true;
+	// O último vértice passa a ocupar o índice denso do vértice eliminado
+	int ultimo = g->numVertices - 1;
+	if (indice != ultimo) {
+		Vertice* movido = g->porIndice[ultimo];
+		movido->indice = indice;
+		g->porIndice[indice] = movido;
+		InserirTabelaIds(&g->ids, movido->id, indice); // O identificador já existe, pelo que não falha por falta de memória
+	}
+	RemoverTabelaIds(&g->ids, idVertice);
+	g->numVertices--;
+	return g;
+}
+
+#pragma endregion
+
+#pragma region DestruirGrafo
+
+/**
+ * @brief Destrói um grafo, libertando todos os vértices, as suas adjacências e a tabela de identificadores.
+ *
+ * @param g O apontador para o grafo a ser destruído.
+ */
+void DestruirGrafo(Grafo* g) {
+	if (g == NULL) return;
+	Vertice* v = g->inicioGrafo;
+	while (v != NULL) {
+		Vertice* seguinte = v->proxVertice;
+		DestruirVertice(v); // Liberta também o vetor de adjacências do vértice
+		v = seguinte;
+	}
+	DestruirTabelaIds(&g->ids);
+	DestruirGrelha(g->grelha);
+	free(g->porIndice);
+	free(g->blocoVertices);
+	free(g->blocoAdjacentes);
+	free(g);
 }
 
 #pragma endregion
@@ -185,14 +336,17 @@ Grafo* EliminarVerticeGrafo(Grafo* g, int idVertice, bool* res) {
 #pragma region MostrarGrafoLA
 
 /**
- * @brief Mostra um grafo representado como lista de adjacncias.
+ * @brief Mostra um grafo representado como lista de adjacências.
  *
- * Esta funo mostra na sada padro o grafo fornecido, que est representado como lista de adjacncias.
+ * Esta função mostra na saída padrão o grafo fornecido, que está representado como lista de adjacências.
  *
  * @param g O apontador para o grafo a ser mostrado.
  */
 void MostrarGrafoLA(Grafo* g) {
-	MostrarGrafo(g->inicioGrafo); // Chama a funo para mostrar o grafo
+	SaidaExportacao* s = CriarSaidaPadrao();
+	if (s == NULL) return;
+	ExportarGrafo(s, g, EXPORTAR_TEXTO); // Mesmo texto de MostrarGrafo, com os adjacentes obtidos pela tabela de identificadores
+	DestruirSaidaExportacao(s);
 }
 
 #pragma endregion
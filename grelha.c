@@ -0,0 +1,438 @@
+/*********************************************************************
+ * @file   grelha.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region GRELHA
+
+#pragma region Auxiliares
+
+/**
+ * Endereço do identificador do vértice da célula (linha, coluna) da matriz.
+ */
+static IdVertice* Celula(Grelha* gr, int linha, int coluna) {
+	return &gr->celulas[(size_t)gr->linhaFisica[linha] * gr->capColunas + gr->colunaFisica[coluna]];
+}
+
+/**
+ * Garante que há espaço para mais uma linha física. As linhas físicas são contíguas, pelo que basta aumentar o vetor.
+ */
+static bool CrescerLinhasGrelha(Grelha* gr) {
+	if (gr->linhas < gr->capLinhas) return true;
+	int capacidade = gr->capLinhas * 2;
+	IdVertice* celulas = (IdVertice*)realloc(gr->celulas, (size_t)capacidade * gr->capColunas * sizeof(IdVertice));
+	if (celulas == NULL) return false;
+	gr->celulas = celulas;
+	int* linhaFisica = (int*)realloc(gr->linhaFisica, capacidade * sizeof(int));
+	if (linhaFisica == NULL) return false;
+	gr->linhaFisica = linhaFisica;
+	gr->capLinhas = capacidade;
+	return true;
+}
+
+/**
+ * Garante que há espaço para mais uma coluna física. Cada linha física é copiada para a sua nova posição.
+ */
+static bool CrescerColunasGrelha(Grelha* gr) {
+	if (gr->colunas < gr->capColunas) return true;
+	int capacidade = gr->capColunas * 2;
+	IdVertice* celulas = (IdVertice*)malloc((size_t)gr->capLinhas * capacidade * sizeof(IdVertice));
+	int* colunaFisica = (int*)realloc(gr->colunaFisica, capacidade * sizeof(int));
+	if (colunaFisica != NULL) gr->colunaFisica = colunaFisica;
+	if (celulas == NULL || colunaFisica == NULL) {
+		free(celulas);
+		return false;
+	}
+	for (int f = 0; f < gr->linhas; f++) {
+		memcpy(&celulas[(size_t)f * capacidade], &gr->celulas[(size_t)f * gr->capColunas], gr->colunas * sizeof(IdVertice));
+	}
+	free(gr->celulas);
+	gr->celulas = celulas;
+	gr->capColunas = capacidade;
+	return true;
+}
+
+/**
+ * Cria um vértice para uma nova célula, com o próximo identificador livre, e insere-o no grafo.
+ * Devolve o identificador do vértice, ou -1 se faltar memória.
+ */
+static IdVertice CriarCelula(Grafo* g, TipoValor valor) {
+	Grelha* gr = g->grelha;
+	while (ExisteVerticeGrafo(g, gr->proximoId)) gr->proximoId++; // Identificador usado por um vértice inserido fora da grelha
+	Vertice* v = CriarVertice(gr->proximoId, valor);
+	if (v == NULL) return -1;
+	int res;
+	InserirVerticeGrafo(g, v, &res);
+	if (res != 1) {
+		DestruirVertice(v);
+		return -1;
+	}
+	return gr->proximoId++;
+}
+
+/**
+ * Insere a aresta entre duas células, acumulando o sucesso da operação em "ok".
+ */
+static void LigarCelulas(Grafo* g, IdVertice origem, IdVertice destino, bool* ok) {
+	bool inserida;
+	InserirAdjGrafo(g, origem, destino, &inserida);
+	if (!inserida) *ok = false;
+}
+
+/**
+ * Elimina a aresta entre duas células.
+ */
+static void DesligarCelulas(Grafo* g, IdVertice origem, IdVertice destino) {
+	bool eliminada;
+	EliminarAdjGrafo(g, origem, destino, &eliminada);
+}
+
+#pragma endregion
+
+#pragma region CriarGrelha
+
+/**
+ * @brief Cria a disposição em matriz dos vértices de um grafo lido de uma matriz.
+ *
+ * As células ficam com os identificadores atribuídos por linhas a partir de 1 (a célula da linha `i` e coluna `j`
+ * tem o identificador `i * colunas + j + 1`), como em LerMatrizDeFicheiro.
+ *
+ * @param linhas O número de linhas da matriz.
+ * @param colunas O número de colunas da matriz.
+ * @return Apontador para a grelha criada, ou NULL se a alocação de memória falhar.
+ */
+Grelha* CriarGrelha(int linhas, int colunas) {
+	if (linhas < 0 || colunas < 0) return NULL;
+	Grelha* gr = (Grelha*)malloc(sizeof(Grelha));
+	if (gr == NULL) return NULL;
+	gr->linhas = linhas;
+	gr->colunas = colunas;
+	gr->capLinhas = linhas > 0 ? linhas : 1;
+	gr->capColunas = colunas > 0 ? colunas : 1;
+	gr->linhaFisica = (int*)malloc(gr->capLinhas * sizeof(int));
+	gr->colunaFisica = (int*)malloc(gr->capColunas * sizeof(int));
+	gr->celulas = (IdVertice*)malloc((size_t)gr->capLinhas * gr->capColunas * sizeof(IdVertice));
+	if (gr->linhaFisica == NULL || gr->colunaFisica == NULL || gr->celulas == NULL) {
+		DestruirGrelha(gr);
+		return NULL;
+	}
+	for (int i = 0; i < linhas; i++) gr->linhaFisica[i] = i;
+	for (int j = 0; j < colunas; j++) gr->colunaFisica[j] = j;
+	for (int i = 0; i < linhas; i++) {
+		for (int j = 0; j < colunas; j++) gr->celulas[(size_t)i * gr->capColunas + j] = (IdVertice)i * colunas + j + 1;
+	}
+	gr->proximoId = (IdVertice)linhas * colunas + 1;
+	return gr;
+}
+
+#pragma endregion
+
+#pragma region ExisteCelulaGrelha
+
+/**
+ * @brief Verifica se uma posição pertence à matriz de um grafo.
+ *
+ * @param g O apontador para o grafo.
+ * @param linha A linha da célula (a contar de 0).
+ * @param coluna A coluna da célula (a contar de 0).
+ * @return `true` se o grafo tiver uma matriz e a posição estiver dentro dela, caso contrário `false`.
+ */
+bool ExisteCelulaGrelha(Grafo* g, int linha, int coluna) {
+	if (g == NULL || g->grelha == NULL) return false;
+	return linha >= 0 && linha < g->grelha->linhas && coluna >= 0 && coluna < g->grelha->colunas;
+}
+
+#pragma endregion
+
+#pragma region IdCelulaGrelha
+
+/**
+ * @brief Obtém o identificador do vértice de uma célula da matriz de um grafo.
+ *
+ * Depois de inserir ou remover linhas ou colunas os identificadores deixam de corresponder à posição na matriz
+ * (os vértices existentes mantêm o seu identificador e as novas células recebem identificadores novos),
+ * pelo que a posição de uma célula deve ser sempre convertida com esta função.
+ *
+ * @param g O apontador para o grafo.
+ * @param linha A linha da célula (a contar de 0).
+ * @param coluna A coluna da célula (a contar de 0).
+ * @return O identificador do vértice da célula, ou -1 se o grafo não tiver uma matriz ou se a posição for inválida
+ *         (como -1 também pode ser o identificador de um vértice, a posição deve ser validada com ExisteCelulaGrelha).
+ */
+IdVertice IdCelulaGrelha(Grafo* g, int linha, int coluna) {
+	if (!ExisteCelulaGrelha(g, linha, coluna)) return -1;
+	return *Celula(g->grelha, linha, coluna);
+}
+
+#pragma endregion
+
+#pragma region AlterarValorGrelha
+
+/**
+ * @brief Altera o valor de uma célula da matriz de um grafo.
+ *
+ * O valor é alterado com AlterarValorVerticeGrafo, em tempo constante.
+ *
+ * @param g O apontador para o grafo.
+ * @param linha A linha da célula (a contar de 0).
+ * @param coluna A coluna da célula (a contar de 0).
+ * @param valor O novo valor da célula.
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Valor alterado.
+ *        - -1: O grafo não tem uma matriz ou a posição é inválida.
+ * @return O apontador para o grafo.
+ */
+Grafo* AlterarValorGrelha(Grafo* g, int linha, int coluna, TipoValor valor, int* res) {
+	*res = -1;
+	if (!ExisteCelulaGrelha(g, linha, coluna)) return g;
+	bool alterado;
+	g = AlterarValorVerticeGrafo(g, IdCelulaGrelha(g, linha, coluna), valor, &alterado);
+	if (alterado) *res = 1;
+	return g;
+}
+
+#pragma endregion
+
+#pragma region InserirLinhaGrelha
+
+/**
+ * @brief Insere uma linha na matriz de um grafo.
+ *
+ * São criados os vértices da nova linha, ligados entre si (para a direita), à linha de cima e à linha de baixo,
+ * e as arestas da linha de cima para a de baixo são retiradas. As linhas são indexadas por uma tabela de linhas
+ * físicas, pelo que o custo é proporcional ao número de colunas e de linhas, e não ao número de células da matriz.
+ *
+ * @param g O apontador para o grafo.
+ * @param linha A posição da nova linha (de 0 a linhas; as linhas a partir dela descem uma posição).
+ * @param valores Os valores das células da nova linha (um por coluna).
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Linha inserida.
+ *        - -1: O grafo não tem uma matriz ou a posição é inválida.
+ *        - -2: Os valores são nulos.
+ *        - -3: Falta de memória.
+ * @return O apontador para o grafo.
+ */
+Grafo* InserirLinhaGrelha(Grafo* g, int linha, const TipoValor* valores, int* res) {
+	*res = -1;
+	if (g == NULL || g->grelha == NULL) return g;
+	Grelha* gr = g->grelha;
+	if (linha < 0 || linha > gr->linhas) return g;
+	*res = -2;
+	if (valores == NULL) return g;
+	*res = -3;
+	if (!CrescerLinhasGrelha(gr)) return g;
+	// Vértices da nova linha, na linha física seguinte às existentes
+	int fisica = gr->linhas;
+	for (int j = 0; j < gr->colunas; j++) {
+		IdVertice id = CriarCelula(g, valores[j]);
+		if (id < 0) {
+			bool eliminado;
+			for (int k = 0; k < j; k++) EliminarVerticeGrafo(g, gr->celulas[(size_t)fisica * gr->capColunas + gr->colunaFisica[k]], &eliminado);
+			return g;
+		}
+		gr->celulas[(size_t)fisica * gr->capColunas + gr->colunaFisica[j]] = id;
+	}
+	memmove(&gr->linhaFisica[linha + 1], &gr->linhaFisica[linha], (gr->linhas - linha) * sizeof(int));
+	gr->linhaFisica[linha] = fisica;
+	gr->linhas++;
+	// Arestas
+	bool ok = true;
+	for (int j = 0; j < gr->colunas; j++) {
+		IdVertice id = *Celula(gr, linha, j);
+		IdVertice cima = linha > 0 ? *Celula(gr, linha - 1, j) : -1;
+		IdVertice baixo = linha + 1 < gr->linhas ? *Celula(gr, linha + 1, j) : -1;
+		if (cima >= 0 && baixo >= 0) DesligarCelulas(g, cima, baixo);
+		if (cima >= 0) LigarCelulas(g, cima, id, &ok);
+		if (baixo >= 0) LigarCelulas(g, id, baixo, &ok);
+		if (j + 1 < gr->colunas) LigarCelulas(g, id, *Celula(gr, linha, j + 1), &ok);
+	}
+	*res = ok ? 1 : -3;
+	return g;
+}
+
+#pragma endregion
+
+#pragma region EliminarLinhaGrelha
+
+/**
+ * @brief Remove uma linha da matriz de um grafo.
+ *
+ * Os vértices da linha são eliminados (com as arestas que chegam a eles), e a linha de cima passa a estar ligada
+ * à linha de baixo. O custo é proporcional ao número de colunas e de linhas, e não ao número de células da matriz.
+ *
+ * @param g O apontador para o grafo.
+ * @param linha A linha a remover (a contar de 0; as linhas seguintes sobem uma posição).
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Linha removida.
+ *        - -1: O grafo não tem uma matriz ou a posição é inválida.
+ *        - -3: Falta de memória ao ligar a linha de cima à de baixo.
+ * @return O apontador para o grafo.
+ */
+Grafo* EliminarLinhaGrelha(Grafo* g, int linha, int* res) {
+	*res = -1;
+	if (g == NULL || g->grelha == NULL) return g;
+	Grelha* gr = g->grelha;
+	if (linha < 0 || linha >= gr->linhas) return g;
+	bool ok = true, eliminado;
+	for (int j = 0; j < gr->colunas; j++) {
+		IdVertice id = *Celula(gr, linha, j);
+		IdVertice cima = linha > 0 ? *Celula(gr, linha - 1, j) : -1;
+		IdVertice baixo = linha + 1 < gr->linhas ? *Celula(gr, linha + 1, j) : -1;
+		if (cima >= 0) DesligarCelulas(g, cima, id);
+		if (cima >= 0 && baixo >= 0) LigarCelulas(g, cima, baixo, &ok);
+		EliminarVerticeGrafo(g, id, &eliminado); // As arestas que saem do vértice são eliminadas com ele
+	}
+	// A última linha física passa a ocupar a linha física libertada
+	int fisica = gr->linhaFisica[linha], ultima = gr->linhas - 1;
+	memmove(&gr->linhaFisica[linha], &gr->linhaFisica[linha + 1], (gr->linhas - linha - 1) * sizeof(int));
+	gr->linhas--;
+	if (fisica != ultima) {
+		memcpy(&gr->celulas[(size_t)fisica * gr->capColunas], &gr->celulas[(size_t)ultima * gr->capColunas], gr->colunas * sizeof(IdVertice));
+		for (int i = 0; i < gr->linhas; i++) {
+			if (gr->linhaFisica[i] == ultima) {
+				gr->linhaFisica[i] = fisica;
+				break;
+			}
+		}
+	}
+	*res = ok ? 1 : -3;
+	return g;
+}
+
+#pragma endregion
+
+#pragma region InserirColunaGrelha
+
+/**
+ * @brief Insere uma coluna na matriz de um grafo.
+ *
+ * São criados os vértices da nova coluna, ligados entre si (para baixo), à coluna da esquerda e à coluna da direita,
+ * e as arestas da coluna da esquerda para a da direita são retiradas. As colunas são indexadas por uma tabela de
+ * colunas físicas, pelo que o custo é proporcional ao número de linhas e de colunas (mais, quando a capacidade
+ * das linhas físicas se esgota, a cópia das células para linhas com o dobro da capacidade).
+ *
+ * @param g O apontador para o grafo.
+ * @param coluna A posição da nova coluna (de 0 a colunas; as colunas a partir dela passam uma posição para a direita).
+ * @param valores Os valores das células da nova coluna (um por linha).
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Coluna inserida.
+ *        - -1: O grafo não tem uma matriz ou a posição é inválida.
+ *        - -2: Os valores são nulos.
+ *        - -3: Falta de memória.
+ * @return O apontador para o grafo.
+ */
+Grafo* InserirColunaGrelha(Grafo* g, int coluna, const TipoValor* valores, int* res) {
+	*res = -1;
+	if (g == NULL || g->grelha == NULL) return g;
+	Grelha* gr = g->grelha;
+	if (coluna < 0 || coluna > gr->colunas) return g;
+	*res = -2;
+	if (valores == NULL) return g;
+	*res = -3;
+	if (!CrescerColunasGrelha(gr)) return g;
+	// Vértices da nova coluna, na coluna física seguinte às existentes
+	int fisica = gr->colunas;
+	for (int i = 0; i < gr->linhas; i++) {
+		IdVertice id = CriarCelula(g, valores[i]);
+		if (id < 0) {
+			bool eliminado;
+			for (int k = 0; k < i; k++) EliminarVerticeGrafo(g, gr->celulas[(size_t)gr->linhaFisica[k] * gr->capColunas + fisica], &eliminado);
+			return g;
+		}
+		gr->celulas[(size_t)gr->linhaFisica[i] * gr->capColunas + fisica] = id;
+	}
+	memmove(&gr->colunaFisica[coluna + 1], &gr->colunaFisica[coluna], (gr->colunas - coluna) * sizeof(int));
+	gr->colunaFisica[coluna] = fisica;
+	gr->colunas++;
+	// Arestas
+	bool ok = true;
+	for (int i = 0; i < gr->linhas; i++) {
+		IdVertice id = *Celula(gr, i, coluna);
+		IdVertice esquerda = coluna > 0 ? *Celula(gr, i, coluna - 1) : -1;
+		IdVertice direita = coluna + 1 < gr->colunas ? *Celula(gr, i, coluna + 1) : -1;
+		if (esquerda >= 0 && direita >= 0) DesligarCelulas(g, esquerda, direita);
+		if (esquerda >= 0) LigarCelulas(g, esquerda, id, &ok);
+		if (direita >= 0) LigarCelulas(g, id, direita, &ok);
+		if (i + 1 < gr->linhas) LigarCelulas(g, id, *Celula(gr, i + 1, coluna), &ok);
+	}
+	*res = ok ? 1 : -3;
+	return g;
+}
+
+#pragma endregion
+
+#pragma region EliminarColunaGrelha
+
+/**
+ * @brief Remove uma coluna da matriz de um grafo.
+ *
+ * Os vértices da coluna são eliminados (com as arestas que chegam a eles), e a coluna da esquerda passa a estar
+ * ligada à coluna da direita. O custo é proporcional ao número de linhas e de colunas, e não ao número de células da matriz.
+ *
+ * @param g O apontador para o grafo.
+ * @param coluna A coluna a remover (a contar de 0; as colunas seguintes passam uma posição para a esquerda).
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Coluna removida.
+ *        - -1: O grafo não tem uma matriz ou a posição é inválida.
+ *        - -3: Falta de memória ao ligar a coluna da esquerda à da direita.
+ * @return O apontador para o grafo.
+ */
+Grafo* EliminarColunaGrelha(Grafo* g, int coluna, int* res) {
+	*res = -1;
+	if (g == NULL || g->grelha == NULL) return g;
+	Grelha* gr = g->grelha;
+	if (coluna < 0 || coluna >= gr->colunas) return g;
+	bool ok = true, eliminado;
+	for (int i = 0; i < gr->linhas; i++) {
+		IdVertice id = *Celula(gr, i, coluna);
+		IdVertice esquerda = coluna > 0 ? *Celula(gr, i, coluna - 1) : -1;
+		IdVertice direita = coluna + 1 < gr->colunas ? *Celula(gr, i, coluna + 1) : -1;
+		if (esquerda >= 0) DesligarCelulas(g, esquerda, id);
+		if (esquerda >= 0 && direita >= 0) LigarCelulas(g, esquerda, direita, &ok);
+		EliminarVerticeGrafo(g, id, &eliminado); // As arestas que saem do vértice são eliminadas com ele
+	}
+	// A última coluna física passa a ocupar a coluna física libertada
+	int fisica = gr->colunaFisica[coluna], ultima = gr->colunas - 1;
+	memmove(&gr->colunaFisica[coluna], &gr->colunaFisica[coluna + 1], (gr->colunas - coluna - 1) * sizeof(int));
+	gr->colunas--;
+	if (fisica != ultima) {
+		for (int i = 0; i < gr->linhas; i++) {
+			IdVertice* linhaCelulas = &gr->celulas[(size_t)i * gr->capColunas];
+			linhaCelulas[fisica] = linhaCelulas[ultima];
+		}
+		for (int j = 0; j < gr->colunas; j++) {
+			if (gr->colunaFisica[j] == ultima) {
+				gr->colunaFisica[j] = fisica;
+				break;
+			}
+		}
+	}
+	*res = ok ? 1 : -3;
+	return g;
+}
+
+#pragma endregion
+
+#pragma region DestruirGrelha
+
+/**
+ * @brief Liberta a memória associada à disposição em matriz de um grafo (os vértices não são alterados).
+ *
+ * @param gr O apontador para a grelha a destruir.
+ */
+void DestruirGrelha(Grelha* gr) {
+	if (gr == NULL) return;
+	free(gr->linhaFisica);
+	free(gr->colunaFisica);
+	free(gr->celulas);
+	free(gr);
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -11,78 +11,388 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <limits.h>
+#include <time.h>
 #include "assert.h"
 #define MAX_VERTICES 25
 #pragma warning(disable:4996)
 
- // Estrutura de dados para representar uma aresta adjacente a um vrtice
-typedef struct Adjacente {
-	int id; // Identificador do vrtice adjacente
-	int valor; // Valor associado  adjacncia
-	int peso; // Peso associado  adjacncia
-	struct Adjacente* proximo; // Apontador para o prximo vrtice adjacente
-} Adjacente;
+// Rastreio das fases (compilar com RASTREIO definido; caso contrário as macros não geram código)
+#ifdef RASTREIO
+#define RASTREIO_INICIO(marca) double marca = InicioRastreio()
+#define RASTREIO_FIM(marca, nome) FimRastreio(nome, marca)
+#else
+#define RASTREIO_INICIO(marca)
+#define RASTREIO_FIM(marca, nome)
+#endif
 
-// Estrutura de dados para representar um vrtice em um grafo
+// Tipo dos valores dos vértices e tipo das somas, escolhidos na compilação: VALOR_16 ou VALOR_64 mudam os valores
+// (32 bits por omissão) e SOMA_32 passa as somas para 32 bits (64 bits por omissão, para não transbordarem em
+// caminhos longos). Os ciclos que percorrem valores e somas são compilados para a largura escolhida.
+#if defined(VALOR_16)
+typedef short TipoValor;
+#define VALOR_MIN SHRT_MIN
+#define VALOR_MAX SHRT_MAX
+#elif defined(VALOR_64)
+typedef long long TipoValor;
+#define VALOR_MIN LLONG_MIN
+#define VALOR_MAX LLONG_MAX
+#else
+typedef int TipoValor;
+#define VALOR_MIN INT_MIN
+#define VALOR_MAX INT_MAX
+#endif
+#if defined(SOMA_32) && !defined(VALOR_64)
+typedef int TipoSoma;
+#define SOMA_MIN INT_MIN
+#define SOMA_MAX INT_MAX
+#else
+typedef long long TipoSoma;
+#define SOMA_MIN LLONG_MIN
+#define SOMA_MAX LLONG_MAX
+#endif
+
+// Identificador externo de um vértice (chave de 64 bits, não necessariamente contígua)
+typedef long long IdVertice;
+
+// Estrutura de dados para representar um vértice em um grafo
 typedef struct Vertice {
-	int id; // Identificador nico do vrtice
-	int valor; // Valor associado ao vrtice
-	bool visitado; // Flag para marcar se o vrtice foi visitado durante a busca
-	Adjacente* proxAdjacente; // Apontador para a lista de vrtices adjacentes
-	struct Vertice* proxVertice; // Apontador para o prximo vrtice no grafo
+	IdVertice id; // Identificador único do vértice
+	int indice; // Índice denso do vértice no grafo (0 a numVertices - 1), atribuído na inserção
+	TipoValor valor; // Valor associado ao vértice
+	bool visitado; // Flag para marcar se o vértice foi visitado durante a busca
+	bool emBloco; // Indica se o vértice está num bloco contíguo do grafo (não pode ser libertado sozinho)
+	IdVertice* adjacentes; // Identificadores dos vértices adjacentes, em memória contígua (o peso de cada aresta é derivado dos valores)
+	int numAdjacentes; // Número de adjacências guardadas em "adjacentes"
+	int capAdjacentes; // Capacidade do vetor "adjacentes"
+	bool adjEmBloco; // Indica se o vetor de adjacências está num bloco contíguo do grafo (não pode ser libertado sozinho)
+	struct Vertice* proxVertice; // Apontador para o próximo vértice no grafo
+	struct Vertice* antVertice; // Apontador para o vértice anterior no grafo
 } Vertice;
 
+// Estrutura de dados para representar uma tabela de dispersão de identificadores de vértices para índices densos
+typedef struct TabelaIds {
+	IdVertice* chaves; // Identificadores guardados
+	int* indices; // Índice denso de cada posição (-1 se a posição estiver livre, -2 se foi removida)
+	int capacidade; // Número de posições (potência de 2)
+	int ocupadas; // Número de posições não livres (incluindo as removidas)
+} TabelaIds;
+
+// Estrutura de dados para representar a disposição em matriz dos vértices de um grafo lido de uma matriz
+typedef struct Grelha {
+	int linhas, colunas; // Dimensões atuais da matriz
+	int capLinhas, capColunas; // Número de linhas e colunas físicas do vetor "celulas"
+	int* linhaFisica; // Linha física de cada linha da matriz
+	int* colunaFisica; // Coluna física de cada coluna da matriz
+	IdVertice* celulas; // Identificador do vértice de cada célula (celulas[linhaFisica * capColunas + colunaFisica])
+	IdVertice proximoId; // Identificador a atribuir à próxima célula criada
+} Grelha;
+
 // Estrutura de dados para representar um grafo
 typedef struct Grafo {
-	Vertice* inicioGrafo; // Apontador para o incio do grafo
-	int numVertices; // Nmero atual de vrtices no grafo
-	int totVertices; // Nmero total de vrtices permitidos no grafo
+	Vertice* inicioGrafo; // Apontador para o início do grafo
+	Vertice* fimGrafo; // Apontador para o último vértice do grafo
+	int numVertices; // Número atual de vértices no grafo
+	int totVertices; // Número total de vértices permitidos no grafo
+	TabelaIds ids; // Tabela de identificadores para índices densos
+	Vertice** porIndice; // Vértice de cada índice denso (mapa inverso da tabela de identificadores)
+	int capIndices; // Capacidade do vetor "porIndice"
+	Vertice* blocoVertices; // Bloco contíguo de vértices criado pela última reordenação (NULL se não existir)
+	IdVertice* blocoAdjacentes; // Bloco contíguo de adjacências criado pela última reordenação (NULL se não existir)
+	Grelha* grelha; // Disposição em matriz dos vértices (NULL se o grafo não tiver sido lido de uma matriz)
 } Grafo;
 
-// Estrutura de dados para representar o resultado de uma operao no grafo
+// Critérios de ordenação dos vértices em memória
+typedef enum OrdemVertices {
+	ORDEM_LARGURA, // Ordem de uma procura em largura (arestas nos dois sentidos)
+	ORDEM_CUTHILL_MCKEE, // Ordem de Cuthill-McKee inversa (reduz a distância entre índices de vértices vizinhos)
+	ORDEM_IDENTIFICADOR // Ordem crescente dos identificadores (por linhas, nas grelhas criadas a partir de uma matriz)
+} OrdemVertices;
+
+// Estrutura de dados para representar o resultado de uma operação no grafo
 typedef struct Resultado {
-	int soma; // Soma dos valores do caminho ou resultado da operao
-	Vertice* caminho; // Apontador para o vrtice que representa o caminho ou o resultado
+	TipoSoma soma; // Soma dos valores do caminho ou resultado da operação
+	Vertice* caminho; // Apontador para o vértice que representa o caminho ou o resultado
 	Grafo* grafo; // Apontador para o grafo associado ao resultado
+	IdVertice* percurso; // Identificadores dos vértices do caminho, pela ordem em que são visitados
+	int tamanho; // Número de vértices guardados em "percurso"
+	bool exato; // Indica se a pesquisa terminou (true) ou se o resultado é parcial (false)
 } Resultado;
 
+// Função chamada periodicamente durante uma pesquisa limitada com a melhor soma encontrada até ao momento
+typedef void (*ProgressoPesquisa)(TipoSoma melhorSoma, long nosExpandidos, void* contexto);
+
+// Estrutura de dados para representar os limites de uma pesquisa
+typedef struct LimitesPesquisa {
+	double tempoMaximo; // Tempo máximo da pesquisa em milissegundos (0 para não limitar)
+	long maxNos; // Número máximo de vértices expandidos (0 para não limitar)
+	long intervaloProgresso; // Número de vértices expandidos entre chamadas à função de progresso
+	ProgressoPesquisa progresso; // Função de progresso (NULL se não for pretendida)
+	void* contexto; // Contexto entregue à função de progresso
+} LimitesPesquisa;
+
+// Estrutura de dados para representar as estatísticas da fronteira de uma pesquisa
+typedef struct EstatisticasPesquisa {
+	long nosExpandidos; // Número de vértices expandidos
+	int profundidadeMaxima; // Maior número de vértices num caminho explorado
+	int fronteiraPendente; // Adjacentes por explorar nos caminhos abertos quando a pesquisa parou
+	int origensPendentes; // Vértices de partida que não chegaram a ser explorados
+	double tempoDecorrido; // Tempo total da pesquisa em milissegundos
+	bool exato; // Indica se a pesquisa terminou sem atingir nenhum limite
+} EstatisticasPesquisa;
+
+// Estrutura de dados para representar uma cópia compacta (só de leitura) de um grafo, com as adjacências em vetores contíguos
+typedef struct GrafoCompacto {
+	int numVertices; // Número de vértices
+	int numArestas; // Número de arestas
+	Grafo* grafo; // Grafo original (NULL nas versões publicadas de um grafo versionado)
+	IdVertice* ids; // Identificador do vértice de cada índice denso
+	TipoValor* valores; // Valor do vértice de cada índice
+	Vertice** vertices; // Apontador para o vértice original de cada índice (NULL nas versões publicadas)
+	TabelaIds* tabelaIds; // Tabela própria de identificadores para índices (NULL: usa a do grafo original)
+	int* inicioAdj; // Posição em "destinos" da primeira adjacência de cada índice (numVertices + 1 posições)
+	int* destinos; // Índices dos vértices de destino de todas as adjacências
+	int* inicioAnt; // Posição em "origens" da primeira aresta que chega a cada índice (numVertices + 1 posições)
+	int* origens; // Índices dos vértices de origem de todas as adjacências, agrupados pelo vértice de destino
+	bool pesosNegativos; // Indica se alguma aresta tem peso negativo (ver VerificarPesosNegativosCompacto)
+} GrafoCompacto;
+
+// Estrutura de dados para representar as opções da enumeração de caminhos simples
+typedef struct OpcoesEnumeracao {
+	bool qualquerOrigem; // Os caminhos podem começar em qualquer vértice (a origem indicada é ignorada)
+	bool qualquerDestino; // Os caminhos podem terminar em qualquer vértice (o destino indicado é ignorado)
+	TipoSoma somaMinima; // Só são entregues os caminhos com soma maior ou igual a este valor
+	int maxVertices; // Número máximo de vértices de cada caminho (0 para não limitar)
+} OpcoesEnumeracao;
+
+// Estrutura de dados para representar o estado de uma enumeração de caminhos simples (pesquisa em profundidade suspensa)
+typedef struct EnumeradorCaminhos {
+	GrafoCompacto* gc; // Grafo compacto percorrido
+	OpcoesEnumeracao opcoes; // Opções da enumeração
+	int origem; // Índice do vértice de origem (ou do próximo vértice de partida, se a origem for qualquer)
+	int destino; // Índice do vértice de destino (-1 se o destino for qualquer)
+	int* pilha; // Índices dos vértices do caminho atual
+	int* proximaAresta; // Próxima aresta a experimentar a partir de cada vértice da pilha
+	TipoSoma* somas; // Soma do caminho até cada posição da pilha
+	bool* noCaminho; // Indica se cada vértice está no caminho atual
+	IdVertice* percurso; // Identificadores dos vértices do caminho atual (o vetor entregue ao consumidor)
+	int profundidade; // Número de vértices do caminho atual
+	long entregues; // Número de caminhos já entregues
+	bool terminado; // Indica se todos os caminhos já foram enumerados
+} EnumeradorCaminhos;
+
+// Função chamada para cada caminho enumerado; devolve false para terminar a enumeração
+typedef bool (*VisitarCaminho)(const IdVertice* percurso, int tamanho, TipoSoma soma, void* contexto);
+
+// Estrutura de dados para representar o estado reutilizável das pesquisas bidirecionais num grafo compacto
+typedef struct PesquisaBidirecional {
+	GrafoCompacto* gc; // Grafo compacto pesquisado
+	int* marca[2]; // Pesquisa em que cada vértice foi alcançado a partir da origem (0) e do destino (1)
+	int* anterior[2]; // Vértice de onde cada vértice foi alcançado, em cada sentido
+	int* distancia[2]; // Número de arestas até cada vértice, em cada sentido
+	int* fila[2]; // Fronteiras das duas pesquisas em largura
+	int selo; // Número da pesquisa atual (evita limpar os vetores entre pesquisas)
+} PesquisaBidirecional;
+
+// Estrutura de dados para representar as opções da pesquisa aproximada do caminho de soma máxima
+typedef struct OpcoesHeuristica {
+	int numReinicios; // Número de caminhos construídos
+	int larguraFeixe; // Número de melhores candidatos entre os quais se escolhe em cada passo
+	unsigned int semente; // Semente dos geradores aleatórios
+	int numThreads; // Número de threads (0 para o número por omissão)
+} OpcoesHeuristica;
+
+// Estrutura de dados para representar uma versão publicada (imutável) de um grafo versionado
+typedef struct VersaoGrafo {
+	GrafoCompacto* gc; // Cópia compacta do grafo nesta versão (só de leitura, com a sua própria tabela de identificadores)
+	long long numero; // Número da versão (a primeira é a 1)
+	bool donoEstrutura; // Indica se a versão liberta as arestas e os identificadores (partilhados com a versão seguinte se esta só mudou valores)
+	long long retiradaEm; // Época em que a versão foi substituída por outra
+	struct VersaoGrafo* proxRetirada; // Próxima versão substituída que ainda não foi libertada
+} VersaoGrafo;
+
+// Estrutura de dados para representar um grafo alterado por um escritor e lido por vários leitores em simultâneo
+typedef struct GrafoVersionado {
+	Grafo* grafo; // Grafo mutável (só pode ser usado pelo escritor)
+	VersaoGrafo* volatile atual; // Última versão publicada
+	volatile long long epoca; // Época global (avança a cada publicação)
+	volatile long long* leitores; // Época fixada por cada leitor, espaçadas para não partilharem linhas de cache (EPOCA_LIVRE se não estiver a ler)
+	int numLeitores; // Número de leitores
+	VersaoGrafo* retiradas; // Versões substituídas à espera de que nenhum leitor as use
+	long long numVersoes; // Número de versões publicadas
+} GrafoVersionado;
+
+// Estrutura de dados para representar o estado (preços e atribuições) de um problema de atribuição numa matriz
+typedef struct Atribuicao {
+	int linhas, colunas; // Dimensões da matriz
+	int n; // Dimensão da matriz quadrada usada no leilão (a maior das duas)
+	int* colunaDe; // Coluna atribuída a cada linha (-1 se nenhuma)
+	int* linhaDe; // Linha atribuída a cada coluna (-1 se nenhuma)
+	long long* precos; // Preço de cada coluna (na escala interna, valores vezes n + 1)
+	TipoSoma soma; // Soma dos valores escolhidos
+	bool resolvida; // Indica se os preços e as atribuições vêm de uma resolução (arranque a quente)
+} Atribuicao;
+
+// Formatos de exportação de um grafo
+typedef enum FormatoExportacao {
+	EXPORTAR_TEXTO, // Lista de adjacências, no formato de MostrarGrafo
+	EXPORTAR_CSV, // Lista de arestas (origem, destino, valores e peso), uma por linha
+	EXPORTAR_DOT // Grafo no formato DOT do Graphviz
+} FormatoExportacao;
+
+// Estrutura de dados para representar o destino de uma exportação: um descritor de ficheiro (escrito em blocos) ou a memória
+typedef struct SaidaExportacao {
+	char* buffer; // Dados ainda não escritos no descritor (ou todos os dados, se o destino for a memória)
+	size_t usados; // Número de bytes ocupados em "buffer"
+	size_t capacidade; // Capacidade de "buffer" (só cresce se o destino for a memória)
+	int descritor; // Descritor de ficheiro de destino (-1 se o destino for a memória)
+	bool saidaPadrao; // Indica se o descritor é o do stdout (o buffer do stdio é descarregado antes de cada escrita)
+	long long totalEscritos; // Número de bytes já escritos no descritor
+	bool erro; // Indica se alguma escrita ou alocação falhou
+} SaidaExportacao;
+
 // Vertices
-Vertice* CriarVertice(int id, int valor);
-bool ExisteVertice(Vertice* inicio, int idVertice);
+Vertice* CriarVertice(IdVertice id, TipoValor valor);
+bool ExisteVertice(Vertice* inicio, IdVertice idVertice);
 Vertice* InserirVertice(Vertice* vertices, Vertice* novoVertice, bool* res);
-Vertice* EliminarVertice(Vertice* vertices, int idVertice, bool* res);
-Vertice* ObterVertice(Vertice* inicio, int idVertice);
+Vertice* EliminarVertice(Vertice* vertices, IdVertice idVertice, bool* res);
+Vertice* ObterVertice(Vertice* inicio, IdVertice idVertice);
+Vertice** IndexarVertices(Vertice* inicio, TabelaIds* ids, int* numVertices);
 void DestruirVertice(Vertice* v);
 void MostrarGrafo(Vertice* grafo);
 
 // Adjacencias
-Adjacente* CriarAdjacente(int id, int valor, int peso);
-Adjacente* EliminarAdjacente(Adjacente* listaAdj, int idAdj, bool* res);
-Adjacente* EliminaTodosAdjacentes(Adjacente* listaAdj, bool* res);
-Vertice* EliminarAdjTodosVertices(Vertice* vertices, int idVertice, bool* res);
-Adjacente* InserirAdjacente(Adjacente* listaAdj, int idDestino, int valor, int peso);
-void DestruirAdjacente(Adjacente* adj);
+TipoSoma PesoAdjacente(Vertice* origem, Vertice* destino);
+Vertice* EliminarAdjacente(Vertice* v, IdVertice idAdj, bool* res);
+Vertice* EliminaTodosAdjacentes(Vertice* v, bool* res);
+Vertice* EliminarAdjTodosVertices(Vertice* vertices, IdVertice idVertice, bool* res);
+Vertice* InserirAdjacente(Vertice* v, IdVertice idDestino, bool* res);
+void DestruirAdjacentes(Vertice* v);
 
 // Grafo
 void MostrarGrafoLA(Grafo* g);
 Grafo* InserirVerticeGrafo(Grafo* g, Vertice* v, int* res);
-Grafo* EliminarVerticeGrafo(Grafo* g, int idVertice, bool* res);
-Grafo* EliminarAdjGrafo(Grafo* g, int idOrigem, int idDestino, bool* res);
-Vertice* OndeEstaVerticeGrafo(Grafo* g, int idVertice);
-Grafo* InserirAdjGrafo(Grafo* g, int idOrigem, int idDestino, bool* res);
+Grafo* EliminarVerticeGrafo(Grafo* g, IdVertice idVertice, bool* res);
+Grafo* AlterarValorVerticeGrafo(Grafo* g, IdVertice idVertice, TipoValor valor, bool* res);
+Grafo* EliminarAdjGrafo(Grafo* g, IdVertice idOrigem, IdVertice idDestino, bool* res);
+Vertice* OndeEstaVerticeGrafo(Grafo* g, IdVertice idVertice);
+Grafo* InserirAdjGrafo(Grafo* g, IdVertice idOrigem, IdVertice idDestino, bool* res);
 Grafo* CriarGrafo(int tot);
-bool ExisteVerticeGrafo(Grafo* g, int idVertice);
+bool ExisteVerticeGrafo(Grafo* g, IdVertice idVertice);
+int IndiceVerticeGrafo(Grafo* g, IdVertice idVertice);
+Vertice* VerticePorIndice(Grafo* g, int indice);
+void DestruirGrafo(Grafo* g);
+
+// Indices
+bool CriarTabelaIds(TabelaIds* t, int capacidade);
+int ObterIndiceTabelaIds(TabelaIds* t, IdVertice id);
+bool InserirTabelaIds(TabelaIds* t, IdVertice id, int indice);
+bool RemoverTabelaIds(TabelaIds* t, IdVertice id);
+void DestruirTabelaIds(TabelaIds* t);
 
 
 // Caminhos
-bool BuscarProfundidade(Vertice* v, int idDestino, bool* visitado, int* soma, Grafo* g);
-int CalcularSomaCaminho(Grafo* g, int idOrigem, int idDestino);
+bool BuscarProfundidade(Vertice* v, IdVertice idDestino, bool* visitado, TipoSoma* soma, Grafo* g);
+TipoSoma CalcularSomaCaminho(Grafo* g, IdVertice idOrigem, IdVertice idDestino);
 
 // Soma
-int AtualizarResultado(Resultado* res, int somaAtual, Vertice* caminhoAtual);
-int BuscarCaminhoMaximo(Vertice* v, int somaAtual, Resultado* res);
+int AtualizarResultado(Resultado* res, TipoSoma somaAtual, Vertice* caminhoAtual);
+int BuscarCaminhoMaximo(Vertice* v, TipoSoma somaAtual, Resultado* res);
 Resultado* CaminhoSomaMaxima(Grafo* g);
 void MostrarSomaMaxima(Grafo* grafo);
+Resultado* CaminhoSomaMaximaLimitado(Grafo* g, LimitesPesquisa* limites, EstatisticasPesquisa* estat);
+void DestruirResultado(Resultado* res);
+Resultado* CaminhoSomaMaximaEntre(Grafo* g, IdVertice idOrigem, IdVertice idDestino, int* res);
+Resultado* CaminhoSomaMaximaEntreCompacto(GrafoCompacto* gc, IdVertice idOrigem, IdVertice idDestino, int* res);
+
+// Grafo compacto
+GrafoCompacto* CriarGrafoCompacto(Grafo* g);
+int IndiceGrafoCompacto(GrafoCompacto* gc, IdVertice idVertice);
+bool VerificarPesosNegativosCompacto(GrafoCompacto* gc);
+void AlterarValorGrafoCompacto(GrafoCompacto* gc, int indice, TipoValor valor);
+void DestruirGrafoCompacto(GrafoCompacto* gc);
+
+// Componentes
+int* ComponentesFortementeLigadas(GrafoCompacto* gc, int* numComponentes);
+Resultado* CaminhoSomaMaximaComponentes(Grafo* g, int* numComponentes, int* maiorComponente);
+
+// Reordenacao
+int* CalcularOrdemVertices(Grafo* g, OrdemVertices criterio);
+Grafo* ReordenarGrafo(Grafo* g, OrdemVertices criterio, bool* res);
+
+// Heuristica
+Resultado* CaminhoSomaMaximaAproximado(Grafo* g, OpcoesHeuristica* opcoes, TipoSoma* limiteSuperior);
+
+// Bidirecional
+PesquisaBidirecional* CriarPesquisaBidirecional(GrafoCompacto* gc);
+Resultado* CaminhoBidirecional(PesquisaBidirecional* p, IdVertice idOrigem, IdVertice idDestino, int* res);
+void DestruirPesquisaBidirecional(PesquisaBidirecional* p);
+
+// Enumeracao
+EnumeradorCaminhos* CriarEnumeradorCaminhos(GrafoCompacto* gc, IdVertice idOrigem, IdVertice idDestino, OpcoesEnumeracao* opcoes, int* res);
+bool ReiniciarEnumeradorCaminhos(EnumeradorCaminhos* e, IdVertice idOrigem, IdVertice idDestino, OpcoesEnumeracao* opcoes, int* res);
+bool ProximoCaminho(EnumeradorCaminhos* e, const IdVertice** percurso, int* tamanho, TipoSoma* soma);
+long EnumerarCaminhos(EnumeradorCaminhos* e, VisitarCaminho visitar, void* contexto);
+void DestruirEnumeradorCaminhos(EnumeradorCaminhos* e);
+
+// Distancias
+Resultado* CaminhoPesoMinimoCompacto(GrafoCompacto* gc, IdVertice idOrigem, IdVertice idDestino, int* res);
+Resultado* CaminhoPesoMinimo(Grafo* g, IdVertice idOrigem, IdVertice idDestino, int* res);
+Resultado* CaminhoPesoMaximoAciclico(Grafo* g, IdVertice idOrigem, IdVertice idDestino, int* res);
+
+// Tempo
+double TempoAtualMs();
+
+// Passos
+Resultado* CaminhoSomaMaximaPassos(Grafo* g, IdVertice idOrigem, int passos, bool ateK, bool comCaminho, int* res);
+
+// Largura
+int* NiveisLargura(GrafoCompacto* gc, IdVertice* sementes, int numSementes, int numThreads, int* numAlcancados);
 
 // Ficheiros
-//Grafo* LerMatrizDeFicheiro(const char* filename, int* res);
\ No newline at end of file
+Grafo* LerMatrizDeFicheiro(const char* nomeFicheiro, int* res);
+
+// Grelha
+Grelha* CriarGrelha(int linhas, int colunas);
+bool ExisteCelulaGrelha(Grafo* g, int linha, int coluna);
+IdVertice IdCelulaGrelha(Grafo* g, int linha, int coluna);
+Grafo* AlterarValorGrelha(Grafo* g, int linha, int coluna, TipoValor valor, int* res);
+Grafo* InserirLinhaGrelha(Grafo* g, int linha, const TipoValor* valores, int* res);
+Grafo* EliminarLinhaGrelha(Grafo* g, int linha, int* res);
+Grafo* InserirColunaGrelha(Grafo* g, int coluna, const TipoValor* valores, int* res);
+Grafo* EliminarColunaGrelha(Grafo* g, int coluna, int* res);
+void DestruirGrelha(Grelha* gr);
+
+// Atribuicao
+Atribuicao* CriarAtribuicao(int linhas, int colunas);
+bool ResolverAtribuicao(Atribuicao* a, const TipoValor* valores, bool aQuente, int numThreads);
+void DestruirAtribuicao(Atribuicao* a);
+
+// Servidor
+long ServirPedidos(Grafo* g, FILE* entrada, FILE* saida, int tamanhoLote, int numThreads);
+
+// Versoes
+GrafoVersionado* CriarGrafoVersionado(Grafo* g, int numLeitores);
+bool PublicarVersao(GrafoVersionado* gv, bool soValores);
+VersaoGrafo* FixarVersao(GrafoVersionado* gv, int leitor);
+void LibertarVersao(GrafoVersionado* gv, int leitor);
+int RecolherVersoes(GrafoVersionado* gv);
+void DestruirGrafoVersionado(GrafoVersionado* gv);
+
+// Rastreio
+void AtivarRastreio(bool ativo);
+double InicioRastreio();
+void FimRastreio(const char* nome, double inicio);
+long ExportarRastreio(const char* nomeFicheiro);
+void LimparRastreio();
+
+// Exportar
+SaidaExportacao* CriarSaidaDescritor(int descritor);
+SaidaExportacao* CriarSaidaPadrao();
+SaidaExportacao* CriarSaidaMemoria();
+bool ExportarGrafo(SaidaExportacao* s, Grafo* g, FormatoExportacao formato);
+bool ExportarVertices(SaidaExportacao* s, Vertice* inicio);
+bool ExportarResultado(SaidaExportacao* s, Resultado* r);
+bool DescarregarSaida(SaidaExportacao* s);
+const char* ConteudoSaida(SaidaExportacao* s, size_t* tamanho);
+bool DestruirSaidaExportacao(SaidaExportacao* s);
\ No newline at end of file
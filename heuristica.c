@@ -0,0 +1,423 @@
+/*********************************************************************
+ * @file   heuristica.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define MAX_LARGURA_FEIXE 16 // Número máximo de candidatos considerados em cada passo da construção
+#define MAX_MELHORIAS 64 // Número máximo de rondas de melhoria local por caminho
+
+#pragma region HEURISTICA
+
+// Área de trabalho de cada thread (reutilizada entre reinícios)
+typedef struct TrabalhoHeuristica {
+	int* caminho; // Índices dos vértices do caminho atual
+	int* auxiliar; // Caminho produzido por uma ronda de melhoria
+	int tamanho; // Número de vértices do caminho atual
+	int* marca; // marca[v] == selo se o vértice v pertence ao caminho atual
+	int selo; // Valor que identifica o reinício atual em "marca"
+	unsigned int estado; // Estado do gerador de números aleatórios
+} TrabalhoHeuristica;
+
+// Vértice candidato a ponto de partida de um reinício
+typedef struct PartidaHeuristica {
+	TipoSoma pontuacao; // Valor do vértice mais o valor do seu melhor adjacente
+	int grau; // Número de adjacentes
+	int indice; // Índice do vértice no grafo compacto
+} PartidaHeuristica;
+
+#pragma region Auxiliares
+
+/**
+ * Gerador de números aleatórios (xorshift) com estado próprio, para poder ser usado por várias threads.
+ */
+static unsigned int Aleatorio(unsigned int* estado) {
+	unsigned int x = *estado;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*estado = x;
+	return x;
+}
+
+/**
+ * Verifica se existe uma aresta entre dois vértices do grafo compacto.
+ */
+static bool ExisteAresta(GrafoCompacto* gc, int origem, int destino) {
+	for (int k = gc->inicioAdj[origem]; k < gc->inicioAdj[origem + 1]; k++) {
+		if (gc->destinos[k] == destino) return true;
+	}
+	return false;
+}
+
+/**
+ * Calcula a pontuação de um vértice como candidato: o seu valor mais o valor do melhor adjacente ainda livre.
+ */
+static TipoSoma PontuacaoCandidato(GrafoCompacto* gc, TrabalhoHeuristica* t, int v) {
+	TipoSoma melhorSeguinte = 0;
+	for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+		int w = gc->destinos[k];
+		if (t->marca[w] != t->selo && gc->valores[w] > melhorSeguinte) melhorSeguinte = gc->valores[w];
+	}
+	return (TipoSoma)gc->valores[v] + melhorSeguinte;
+}
+
+/**
+ * Calcula a soma dos valores do caminho atual.
+ */
+static TipoSoma SomaCaminho(GrafoCompacto* gc, TrabalhoHeuristica* t) {
+	TipoSoma soma = 0;
+	for (int i = 0; i < t->tamanho; i++) soma += gc->valores[t->caminho[i]];
+	return soma;
+}
+
+/**
+ * Compara dois vértices de partida, por ordem decrescente de pontuação e de número de adjacentes (para qsort).
+ */
+static int CompararPartidas(const void* a, const void* b) {
+	const PartidaHeuristica* pa = (const PartidaHeuristica*)a;
+	const PartidaHeuristica* pb = (const PartidaHeuristica*)b;
+	if (pa->pontuacao != pb->pontuacao) return pa->pontuacao > pb->pontuacao ? -1 : 1;
+	if (pa->grau != pb->grau) return pa->grau > pb->grau ? -1 : 1;
+	return pa->indice - pb->indice;
+}
+
+#pragma endregion
+
+#pragma region ProlongarCaminho
+
+/**
+ * Prolonga o caminho a partir do último vértice, escolhendo em cada passo um dos `largura` melhores adjacentes livres.
+ *
+ * Com `largura` igual a 1 a escolha é gulosa (sempre o melhor candidato); com valores maiores a escolha é aleatória
+ * entre os melhores, o que dá caminhos diferentes em cada reinício.
+ *
+ * @param gc O grafo compacto.
+ * @param t A área de trabalho da thread.
+ * @param largura O número de candidatos entre os quais se escolhe.
+ */
+static void ProlongarCaminho(GrafoCompacto* gc, TrabalhoHeuristica* t, int largura) {
+	int candidatos[MAX_LARGURA_FEIXE];
+	TipoSoma pontuacoes[MAX_LARGURA_FEIXE];
+	while (t->tamanho > 0) {
+		int atual = t->caminho[t->tamanho - 1];
+		int numCandidatos = 0;
+		// Manter os "largura" melhores adjacentes livres, ordenados por pontuação
+		for (int k = gc->inicioAdj[atual]; k < gc->inicioAdj[atual + 1]; k++) {
+			int w = gc->destinos[k];
+			if (t->marca[w] == t->selo) continue;
+			TipoSoma p = PontuacaoCandidato(gc, t, w);
+			int pos = numCandidatos < largura ? numCandidatos++ : largura;
+			while (pos > 0 && pontuacoes[pos - 1] < p) {
+				if (pos < largura) {
+					candidatos[pos] = candidatos[pos - 1];
+					pontuacoes[pos] = pontuacoes[pos - 1];
+				}
+				pos--;
+			}
+			if (pos < largura) {
+				candidatos[pos] = w;
+				pontuacoes[pos] = p;
+			}
+		}
+		if (numCandidatos == 0) return; // Não há para onde prolongar
+		int escolhido = candidatos[numCandidatos > 1 ? Aleatorio(&t->estado) % numCandidatos : 0];
+		t->marca[escolhido] = t->selo;
+		t->caminho[t->tamanho++] = escolhido;
+	}
+}
+
+#pragma endregion
+
+#pragma region MelhorarCaminho
+
+/**
+ * Faz uma ronda de melhoria local sobre o caminho atual.
+ *
+ * Para cada par de vértices consecutivos (a, b) do caminho são tentados dois movimentos:
+ * - atalho: se b tem valor negativo e existe a aresta de a para o vértice seguinte a b, b é retirado;
+ * - desvio: se existe um vértice livre x com as arestas a->x e x->b, ou dois vértices livres x e y com as arestas
+ *   a->x, x->y e y->b, o desvio de maior soma positiva é inserido entre a e b (nas grelhas só o desvio com dois
+ *   vértices é possível).
+ * No fim o caminho é prolongado de forma gulosa a partir do último vértice.
+ *
+ * @param gc O grafo compacto.
+ * @param t A área de trabalho da thread.
+ * @return Retorna true se o caminho foi alterado.
+ */
+static bool MelhorarCaminho(GrafoCompacto* gc, TrabalhoHeuristica* t) {
+	bool alterado = false;
+	int* novo = t->auxiliar;
+	int tamanho = 0;
+	novo[tamanho++] = t->caminho[0];
+	for (int i = 1; i < t->tamanho; i++) {
+		int a = novo[tamanho - 1];
+		int b = t->caminho[i];
+		// Atalho sobre um vértice de valor negativo
+		if (gc->valores[b] < 0 && i + 1 < t->tamanho && ExisteAresta(gc, a, t->caminho[i + 1])) {
+			t->marca[b] = 0;
+			alterado = true;
+			continue;
+		}
+		// Inserção de um desvio livre entre a e b, com um (a->x->b) ou dois vértices (a->x->y->b)
+		int melhorX = -1, melhorY = -1;
+		TipoSoma melhorGanho = 0;
+		for (int k = gc->inicioAdj[a]; k < gc->inicioAdj[a + 1]; k++) {
+			int x = gc->destinos[k];
+			if (t->marca[x] == t->selo) continue;
+			if (gc->valores[x] > melhorGanho && ExisteAresta(gc, x, b)) {
+				melhorGanho = gc->valores[x];
+				melhorX = x;
+				melhorY = -1;
+			}
+			for (int j = gc->inicioAdj[x]; j < gc->inicioAdj[x + 1]; j++) {
+				int y = gc->destinos[j];
+				TipoSoma ganho = (TipoSoma)gc->valores[x] + gc->valores[y];
+				if (y == x || t->marca[y] == t->selo || ganho <= melhorGanho) continue;
+				if (ExisteAresta(gc, y, b)) {
+					melhorGanho = ganho;
+					melhorX = x;
+					melhorY = y;
+				}
+			}
+		}
+		if (melhorX >= 0) {
+			t->marca[melhorX] = t->selo;
+			novo[tamanho++] = melhorX;
+			if (melhorY >= 0) {
+				t->marca[melhorY] = t->selo;
+				novo[tamanho++] = melhorY;
+			}
+			alterado = true;
+		}
+		novo[tamanho++] = b;
+	}
+	// Trocar os dois vetores
+	t->auxiliar = t->caminho;
+	t->caminho = novo;
+	int tamanhoAnterior = tamanho;
+	t->tamanho = tamanho;
+	ProlongarCaminho(gc, t, 1);
+	return alterado || t->tamanho != tamanhoAnterior;
+}
+
+#pragma endregion
+
+#pragma region CortarCaminho
+
+/**
+ * Reduz o caminho ao troço contíguo de soma máxima (algoritmo de Kadane), libertando os vértices retirados.
+ *
+ * @param gc O grafo compacto.
+ * @param t A área de trabalho da thread.
+ */
+static void CortarCaminho(GrafoCompacto* gc, TrabalhoHeuristica* t) {
+	TipoSoma melhor = gc->valores[t->caminho[0]], atual = 0;
+	int inicioMelhor = 0, fimMelhor = 0, inicioAtual = 0;
+	for (int i = 0; i < t->tamanho; i++) {
+		if (atual <= 0) {
+			atual = 0;
+			inicioAtual = i;
+		}
+		atual += gc->valores[t->caminho[i]];
+		if (atual > melhor) {
+			melhor = atual;
+			inicioMelhor = inicioAtual;
+			fimMelhor = i;
+		}
+	}
+	for (int i = 0; i < t->tamanho; i++) {
+		if (i < inicioMelhor || i > fimMelhor) t->marca[t->caminho[i]] = 0;
+	}
+	t->tamanho = fimMelhor - inicioMelhor + 1;
+	memmove(t->caminho, t->caminho + inicioMelhor, t->tamanho * sizeof(int));
+}
+
+#pragma endregion
+
+#pragma region LimiteSuperiorSomaMaxima
+
+/**
+ * Calcula um limite superior para a soma de qualquer caminho simples do grafo compacto.
+ *
+ * Num caminho, um vértice sem arestas de entrada só pode ser o primeiro e um vértice sem arestas de saída
+ * só pode ser o último. O limite é a soma dos valores positivos dos vértices com entradas e saídas, mais o melhor
+ * valor positivo de cada um dos dois extremos. Se nenhum valor for positivo, o limite é o maior valor.
+ *
+ * @param gc O grafo compacto.
+ * @return O limite superior.
+ */
+static TipoSoma LimiteSuperiorSomaMaxima(GrafoCompacto* gc) {
+	int n = gc->numVertices;
+	int* grauEntrada = (int*)calloc(n + 1, sizeof(int));
+	if (grauEntrada == NULL) return SOMA_MAX;
+	for (int k = 0; k < gc->numArestas; k++) grauEntrada[gc->destinos[k]]++;
+	TipoSoma interior = 0, melhorOrigem = 0, melhorFim = 0, maiorValor = gc->valores[0];
+	for (int v = 0; v < n; v++) {
+		TipoSoma valor = gc->valores[v];
+		bool temEntrada = grauEntrada[v] > 0;
+		bool temSaida = gc->inicioAdj[v + 1] > gc->inicioAdj[v];
+		if (valor > maiorValor) maiorValor = valor;
+		if (valor <= 0) continue;
+		if (temEntrada && temSaida) interior += valor;
+		else if (temSaida && valor > melhorOrigem) melhorOrigem = valor;
+		else if (temEntrada && valor > melhorFim) melhorFim = valor;
+	}
+	free(grauEntrada);
+	if (maiorValor <= 0) return maiorValor;
+	TipoSoma limite = interior + melhorOrigem + melhorFim;
+	return limite > maiorValor ? limite : maiorValor; // Um vértice isolado pode ser, sozinho, o melhor caminho
+}
+
+#pragma endregion
+
+#pragma region CaminhoSomaMaximaAproximado
+
+/**
+ * Função para encontrar um caminho de soma elevada num grafo demasiado grande para a pesquisa exaustiva.
+ *
+ * Esta função constrói vários caminhos de forma gulosa e aleatória (reinícios), partindo dos vértices com melhor
+ * pontuação (valor do vértice mais o valor do seu melhor adjacente, com desempate pelo número de adjacentes).
+ * Cada caminho é melhorado localmente com atalhos sobre vértices negativos, desvios por vértices livres entre
+ * vértices consecutivos e prolongamento do fim, e é por último reduzido ao troço de soma máxima.
+ * Os reinícios são distribuídos pelas threads disponíveis (OpenMP) e cada um usa o seu próprio gerador
+ * aleatório, pelo que o resultado não depende do número de threads.
+ *
+ * @param g O apontador para o grafo onde o caminho será procurado.
+ * @param opcoes O apontador para as opções da heurística (NULL para as opções por omissão).
+ * @param limiteSuperior Apontador onde é guardado um limite superior para a soma máxima exata (pode ser NULL).
+ * @return Retorna um apontador para o resultado com o melhor caminho encontrado, a destruir com DestruirResultado.
+ *         O resultado é marcado como exato quando a sua soma atinge o limite superior.
+ *         Retorna NULL se o grafo for nulo ou vazio, ou se não for possível alocar memória (incluindo os vetores
+ *         de trabalho de qualquer uma das threads, para nunca devolver um resultado a que faltem reinícios).
+ */
+Resultado* CaminhoSomaMaximaAproximado(Grafo* g, OpcoesHeuristica* opcoes, TipoSoma* limiteSuperior) {
+	OpcoesHeuristica omissao = { 64, 3, 1, 0 };
+	if (opcoes == NULL) opcoes = &omissao;
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	if (gc == NULL) return NULL;
+	int n = gc->numVertices;
+	if (n == 0) {
+		DestruirGrafoCompacto(gc);
+		return NULL;
+	}
+	int numReinicios = opcoes->numReinicios > 0 ? opcoes->numReinicios : omissao.numReinicios;
+	int largura = opcoes->larguraFeixe > 0 ? opcoes->larguraFeixe : omissao.larguraFeixe;
+	if (largura > MAX_LARGURA_FEIXE) largura = MAX_LARGURA_FEIXE;
+	// Ordenar os vértices de partida pela pontuação (valor + melhor adjacente, depois número de adjacentes)
+	PartidaHeuristica* partidas = (PartidaHeuristica*)malloc(n * sizeof(PartidaHeuristica));
+	int* melhorCaminho = (int*)malloc(n * sizeof(int));
+	if (partidas == NULL || melhorCaminho == NULL) {
+		free(partidas);
+		free(melhorCaminho);
+		DestruirGrafoCompacto(gc);
+		return NULL;
+	}
+	for (int v = 0; v < n; v++) {
+		TipoSoma melhorAdj = 0;
+		for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+			if (gc->valores[gc->destinos[k]] > melhorAdj) melhorAdj = gc->valores[gc->destinos[k]];
+		}
+		partidas[v].pontuacao = (TipoSoma)gc->valores[v] + melhorAdj;
+		partidas[v].grau = gc->inicioAdj[v + 1] - gc->inicioAdj[v];
+		partidas[v].indice = v;
+	}
+	qsort(partidas, n, sizeof(PartidaHeuristica), CompararPartidas);
+	TipoSoma melhorSoma = 0;
+	int melhorTamanho = 0, melhorReinicio = -1;
+	bool faltaMemoria = false; // Alguma thread não conseguiu alocar os seus vetores (os seus reinícios ficaram por fazer)
+	int numThreads = 1;
+#ifdef _OPENMP
+	numThreads = opcoes->numThreads > 0 ? opcoes->numThreads : omp_get_max_threads();
+#else
+	(void)numThreads;
+#endif
+#pragma omp parallel num_threads(numThreads)
+	{
+		TrabalhoHeuristica t;
+		t.caminho = (int*)malloc(n * sizeof(int));
+		t.auxiliar = (int*)malloc(n * sizeof(int));
+		t.marca = (int*)calloc(n, sizeof(int));
+		t.selo = 0;
+		t.tamanho = 0;
+		bool valido = t.caminho != NULL && t.auxiliar != NULL && t.marca != NULL;
+		if (!valido) {
+#pragma omp critical(faltaMemoriaAproximado) // E não "atomic write", que não existe no OpenMP 2.0 (MSVC)
+			faltaMemoria = true;
+		}
+#pragma omp for schedule(dynamic, 1)
+		for (int r = 0; r < numReinicios; r++) {
+			if (!valido) continue; // A thread tem de chegar ao fim do ciclo, mas o resultado já vai ser descartado
+			t.estado = (opcoes->semente * 2654435761u) ^ (unsigned int)(r + 1) * 40503u;
+			if (t.estado == 0) t.estado = 1;
+			t.selo++;
+			int partida = partidas[r % n].indice;
+			t.caminho[0] = partida;
+			t.tamanho = 1;
+			t.marca[partida] = t.selo;
+			ProlongarCaminho(gc, &t, largura);
+			// Melhoria local até estabilizar
+			TipoSoma soma = SomaCaminho(gc, &t);
+			for (int ronda = 0; ronda < MAX_MELHORIAS; ronda++) {
+				if (!MelhorarCaminho(gc, &t)) break;
+				TipoSoma novaSoma = SomaCaminho(gc, &t);
+				if (novaSoma <= soma) break;
+				soma = novaSoma;
+			}
+			CortarCaminho(gc, &t);
+			soma = SomaCaminho(gc, &t);
+#pragma omp critical(melhorCaminhoAproximado)
+			{
+				// Em caso de empate fica o reinício de menor número, para o resultado ser determinista
+				if (melhorReinicio < 0 || soma > melhorSoma || (soma == melhorSoma && r < melhorReinicio)) {
+					melhorSoma = soma;
+					melhorReinicio = r;
+					melhorTamanho = t.tamanho;
+					memcpy(melhorCaminho, t.caminho, t.tamanho * sizeof(int));
+				}
+			}
+		}
+		free(t.caminho);
+		free(t.auxiliar);
+		free(t.marca);
+	}
+	if (faltaMemoria) { // Faltariam reinícios ao resultado, que deixaria de ser determinista
+		free(partidas);
+		free(melhorCaminho);
+		DestruirGrafoCompacto(gc);
+		return NULL;
+	}
+	TipoSoma limite = LimiteSuperiorSomaMaxima(gc);
+	if (limiteSuperior != NULL) *limiteSuperior = limite;
+	Resultado* res = (Resultado*)malloc(sizeof(Resultado));
+	if (res != NULL) {
+		res->soma = melhorSoma;
+		res->grafo = g;
+		res->tamanho = melhorTamanho;
+		res->percurso = (IdVertice*)malloc((melhorTamanho > 0 ? melhorTamanho : 1) * sizeof(IdVertice));
+		res->caminho = melhorTamanho > 0 ? gc->vertices[melhorCaminho[melhorTamanho - 1]] : NULL;
+		res->exato = melhorTamanho > 0 && melhorSoma == limite;
+		if (res->percurso == NULL) {
+			free(res);
+			res = NULL;
+		}
+		else {
+			for (int i = 0; i < melhorTamanho; i++) res->percurso[i] = gc->ids[melhorCaminho[i]];
+		}
+	}
+	free(partidas);
+	free(melhorCaminho);
+	DestruirGrafoCompacto(gc);
+	return res;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,193 @@
+/*********************************************************************
+ * @file   indices.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#define POSICAO_LIVRE -1 // Posição da tabela que nunca foi ocupada
+#define POSICAO_REMOVIDA -2 // Posição da tabela cujo identificador foi removido
+
+#pragma region INDICES
+
+#pragma region Dispersao
+
+ /**
+  * @brief Calcula a posição inicial de um identificador na tabela.
+  *
+  * Os bits do identificador são misturados (função de finalização do splitmix64) para que
+  * identificadores consecutivos ou com padrões regulares fiquem espalhados pela tabela.
+  *
+  * @param id O identificador do vértice.
+  * @param capacidade A capacidade da tabela (potência de 2).
+  * @return A posição inicial do identificador.
+  */
+static int Dispersao(IdVertice id, int capacidade) {
+	unsigned long long x = (unsigned long long)id;
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return (int)(x & (unsigned long long)(capacidade - 1));
+}
+
+#pragma endregion
+
+#pragma region CriarTabelaIds
+
+/**
+ * @brief Inicializa uma tabela de identificadores vazia.
+ *
+ * @param t Apontador para a tabela a inicializar.
+ * @param capacidade Número de identificadores previsto (a capacidade real é a potência de 2 seguinte ao dobro deste valor).
+ * @return `true` se a tabela foi criada, `false` se a alocação de memória falhar.
+ */
+bool CriarTabelaIds(TabelaIds* t, int capacidade) {
+	int cap = 16;
+	while (cap < capacidade * 2) cap *= 2;
+	t->chaves = (IdVertice*)malloc(cap * sizeof(IdVertice));
+	t->indices = (int*)malloc(cap * sizeof(int));
+	t->capacidade = cap;
+	t->ocupadas = 0;
+	if (t->chaves == NULL || t->indices == NULL) {
+		DestruirTabelaIds(t);
+		return false;
+	}
+	for (int i = 0; i < cap; i++) t->indices[i] = POSICAO_LIVRE;
+	return true;
+}
+
+#pragma endregion
+
+#pragma region ObterIndiceTabelaIds
+
+/**
+ * @brief Obtém o índice denso associado a um identificador.
+ *
+ * @param t Apontador para a tabela.
+ * @param id O identificador a procurar.
+ * @return O índice denso do identificador, ou -1 se não existir na tabela.
+ */
+int ObterIndiceTabelaIds(TabelaIds* t, IdVertice id) {
+	if (t == NULL || t->capacidade == 0) return -1;
+	int mascara = t->capacidade - 1;
+	for (int pos = Dispersao(id, t->capacidade); t->indices[pos] != POSICAO_LIVRE; pos = (pos + 1) & mascara) {
+		if (t->indices[pos] >= 0 && t->chaves[pos] == id) return t->indices[pos];
+	}
+	return -1;
+}
+
+#pragma endregion
+
+#pragma region InserirTabelaIds
+
+/**
+ * @brief Reconstrói a tabela com capacidade para o dobro dos identificadores guardados, descartando as posições removidas.
+ *
+ * @param t Apontador para a tabela.
+ * @return `true` se o redimensionamento foi feito, `false` se a alocação de memória falhar.
+ */
+static bool CrescerTabelaIds(TabelaIds* t) {
+	TabelaIds nova;
+	int guardados = 0;
+	for (int i = 0; i < t->capacidade; i++) {
+		if (t->indices[i] >= 0) guardados++;
+	}
+	if (!CriarTabelaIds(&nova, (guardados + 1) * 2)) return false;
+	for (int i = 0; i < t->capacidade; i++) {
+		if (t->indices[i] >= 0) InserirTabelaIds(&nova, t->chaves[i], t->indices[i]);
+	}
+	DestruirTabelaIds(t);
+	*t = nova;
+	return true;
+}
+
+/**
+ * @brief Associa um identificador a um índice denso.
+ *
+ * Se o identificador já existir, o seu índice é atualizado sem ocupar mais posições, pelo que esta
+ * atualização nunca falha. Um identificador novo faz crescer a tabela quando esta fica ocupada acima
+ * de metade da capacidade.
+ *
+ * @param t Apontador para a tabela.
+ * @param id O identificador a inserir.
+ * @param indice O índice denso a associar ao identificador.
+ * @return `true` se a inserção foi feita, `false` se a alocação de memória falhar.
+ */
+bool InserirTabelaIds(TabelaIds* t, IdVertice id, int indice) {
+	if (t == NULL) return false;
+	int removida = -1; // Primeira posição removida encontrada, que pode ser reaproveitada
+	int pos = 0;
+	if (t->capacidade > 0) {
+		// O identificador é procurado antes de a tabela crescer, porque atualizar um que já existe não precisa de espaço
+		int mascara = t->capacidade - 1;
+		for (pos = Dispersao(id, t->capacidade); t->indices[pos] != POSICAO_LIVRE; pos = (pos + 1) & mascara) {
+			if (t->indices[pos] >= 0 && t->chaves[pos] == id) {
+				t->indices[pos] = indice; // O identificador já existe
+				return true;
+			}
+			if (t->indices[pos] == POSICAO_REMOVIDA && removida < 0) removida = pos;
+		}
+	}
+	if (removida < 0 && (t->ocupadas + 1) * 2 > t->capacidade) {
+		if (!CrescerTabelaIds(t)) return false;
+		return InserirTabelaIds(t, id, indice); // Procura a posição na tabela nova (que já tem espaço)
+	}
+	if (removida >= 0) pos = removida;
+	else t->ocupadas++;
+	t->chaves[pos] = id;
+	t->indices[pos] = indice;
+	return true;
+}
+
+#pragma endregion
+
+#pragma region RemoverTabelaIds
+
+/**
+ * @brief Remove um identificador da tabela.
+ *
+ * A posição é marcada como removida para não interromper as sequências de procura que passam por ela.
+ *
+ * @param t Apontador para a tabela.
+ * @param id O identificador a remover.
+ * @return `true` se o identificador existia e foi removido, caso contrário `false`.
+ */
+bool RemoverTabelaIds(TabelaIds* t, IdVertice id) {
+	if (t == NULL || t->capacidade == 0) return false;
+	int mascara = t->capacidade - 1;
+	for (int pos = Dispersao(id, t->capacidade); t->indices[pos] != POSICAO_LIVRE; pos = (pos + 1) & mascara) {
+		if (t->indices[pos] >= 0 && t->chaves[pos] == id) {
+			t->indices[pos] = POSICAO_REMOVIDA;
+			return true;
+		}
+	}
+	return false;
+}
+
+#pragma endregion
+
+#pragma region DestruirTabelaIds
+
+/**
+ * @brief Liberta a memória associada a uma tabela de identificadores.
+ *
+ * @param t Apontador para a tabela a destruir (a estrutura em si não é libertada).
+ */
+void DestruirTabelaIds(TabelaIds* t) {
+	if (t == NULL) return;
+	free(t->chaves);
+	free(t->indices);
+	t->chaves = NULL;
+	t->indices = NULL;
+	t->capacidade = 0;
+	t->ocupadas = 0;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
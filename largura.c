@@ -0,0 +1,204 @@
+/*********************************************************************
+ * @file   largura.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define BITS_PALAVRA 64 // Número de vértices representados em cada palavra de um conjunto de bits
+#define ALFA_LARGURA 14 // Passa a ascendente quando as arestas da fronteira excedem 1/ALFA das arestas por visitar
+#define BETA_LARGURA 24 // Volta a descendente quando a fronteira tem menos de 1/BETA dos vértices
+
+#pragma region LARGURA
+
+#pragma region Auxiliares
+
+/**
+ * Verifica se um vértice pertence a um conjunto de bits.
+ */
+static bool TemBit(unsigned long long* conjunto, int v) {
+	return (conjunto[v / BITS_PALAVRA] >> (v % BITS_PALAVRA)) & 1ULL;
+}
+
+/**
+ * Passo descendente: os adjacentes ainda não visitados de cada vértice da fronteira (guardada numa lista) são
+ * copiados para "candidatos", a partir da posição de cada vértice (soma dos graus dos vértices anteriores), pelo que
+ * as threads não escrevem nas mesmas posições. Depois os candidatos são marcados como visitados e formam a nova lista.
+ * Devolve o número de vértices da nova fronteira e, em "arestas", a soma dos seus graus de saída.
+ */
+static int PassoDescendente(GrafoCompacto* gc, int* fila, int tamanho, int* seguinte, int* candidatos, int* posicao,
+	unsigned long long* visitados, int* nivel, int profundidade, int numThreads, long long* arestas) {
+#ifndef _OPENMP
+	(void)numThreads; // Só é usado pelas diretivas OpenMP
+#endif
+	int total = 0;
+	for (int i = 0; i < tamanho; i++) {
+		posicao[i] = total;
+		total += gc->inicioAdj[fila[i] + 1] - gc->inicioAdj[fila[i]];
+	}
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 256)
+	for (int i = 0; i < tamanho; i++) {
+		int v = fila[i];
+		int j = posicao[i];
+		for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++, j++) {
+			int w = gc->destinos[k];
+			candidatos[j] = TemBit(visitados, w) ? -1 : w;
+		}
+	}
+	int novos = 0;
+	long long grau = 0;
+	for (int j = 0; j < total; j++) {
+		int w = candidatos[j];
+		if (w < 0 || TemBit(visitados, w)) continue;
+		visitados[w / BITS_PALAVRA] |= 1ULL << (w % BITS_PALAVRA);
+		nivel[w] = profundidade;
+		seguinte[novos++] = w;
+		grau += gc->inicioAdj[w + 1] - gc->inicioAdj[w];
+	}
+	*arestas = grau;
+	return novos;
+}
+
+/**
+ * Passo ascendente: cada vértice ainda não visitado procura, entre as arestas que chegam a ele, uma que venha
+ * da fronteira (guardada num conjunto de bits). Cada thread só escreve nas palavras dos seus vértices, pelo que
+ * não são precisas operações atómicas. Os vértices encontrados são depois acrescentados, por ordem, à nova lista.
+ * Devolve o número de vértices da nova fronteira e, em "arestas", a soma dos seus graus de saída.
+ */
+static int PassoAscendente(GrafoCompacto* gc, unsigned long long* fronteira, unsigned long long* novos, int* seguinte,
+	unsigned long long* visitados, int* nivel, int profundidade, int numPalavras, int numThreads, long long* arestas) {
+#ifndef _OPENMP
+	(void)numThreads; // Só é usado pelas diretivas OpenMP
+#endif
+	int n = gc->numVertices;
+	long long grau = 0;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 64) reduction(+:grau)
+	for (int p = 0; p < numPalavras; p++) {
+		unsigned long long porVisitar = ~visitados[p];
+		unsigned long long encontrados = 0;
+		for (int bit = 0; bit < BITS_PALAVRA && porVisitar != 0; bit++) {
+			int v = p * BITS_PALAVRA + bit;
+			if (v >= n) break;
+			if (((porVisitar >> bit) & 1ULL) == 0) continue;
+			for (int k = gc->inicioAnt[v]; k < gc->inicioAnt[v + 1]; k++) {
+				if (TemBit(fronteira, gc->origens[k])) {
+					encontrados |= 1ULL << bit;
+					nivel[v] = profundidade;
+					grau += gc->inicioAdj[v + 1] - gc->inicioAdj[v];
+					break;
+				}
+			}
+		}
+		novos[p] = encontrados;
+	}
+	int tamanho = 0;
+	for (int p = 0; p < numPalavras; p++) {
+		visitados[p] |= novos[p];
+		unsigned long long palavra = novos[p];
+		for (int bit = 0; palavra != 0; bit++, palavra >>= 1) {
+			if (palavra & 1ULL) seguinte[tamanho++] = p * BITS_PALAVRA + bit;
+		}
+	}
+	*arestas = grau;
+	return tamanho;
+}
+
+#pragma endregion
+
+#pragma region NiveisLargura
+
+/**
+ * @brief Calcula, com uma procura em largura, o nível (número de arestas) de cada vértice a partir de um conjunto de sementes.
+ *
+ * Os vértices visitados são guardados num conjunto de bits. Em cada nível a procura escolhe o sentido mais barato:
+ * descendente (a fronteira, numa lista, visita as arestas de saída) enquanto a fronteira é pequena, e ascendente
+ * (a fronteira passa a um conjunto de bits e os vértices por visitar procuram nela um antecessor, pelas arestas de
+ * entrada) quando as arestas da fronteira passam a ser uma fração grande das arestas por visitar. A expansão de cada
+ * nível pode ser dividida por várias threads.
+ *
+ * @param gc Apontador para o grafo compacto (com as arestas nos dois sentidos).
+ * @param sementes Identificadores dos vértices de partida (nível 0). Os identificadores inexistentes são ignorados.
+ * @param numSementes Número de sementes.
+ * @param numThreads Número de threads (0 para o número por omissão).
+ * @param numAlcancados Apontador onde é guardado o número de vértices alcançados, incluindo as sementes (pode ser NULL).
+ * @return Vetor com o nível de cada índice de vértice, ou -1 se o vértice não for alcançável (a libertar com `free`),
+ *         ou `NULL` se o grafo for nulo ou se a alocação de memória falhar.
+ */
+int* NiveisLargura(GrafoCompacto* gc, IdVertice* sementes, int numSementes, int numThreads, int* numAlcancados) {
+	if (numAlcancados != NULL) *numAlcancados = 0;
+	if (gc == NULL) return NULL;
+	int n = gc->numVertices;
+	int numPalavras = (n + BITS_PALAVRA - 1) / BITS_PALAVRA;
+	int* nivel = (int*)malloc((n + 1) * sizeof(int));
+	int* fila = (int*)malloc((n + 1) * sizeof(int)); // Fronteira atual
+	int* seguinte = (int*)malloc((n + 1) * sizeof(int)); // Nova fronteira
+	int* posicao = (int*)malloc((n + 1) * sizeof(int));
+	int* candidatos = (int*)malloc((gc->numArestas + 1) * sizeof(int));
+	unsigned long long* fronteira = (unsigned long long*)calloc(numPalavras + 1, sizeof(unsigned long long));
+	unsigned long long* novos = (unsigned long long*)calloc(numPalavras + 1, sizeof(unsigned long long));
+	unsigned long long* visitados = (unsigned long long*)calloc(numPalavras + 1, sizeof(unsigned long long));
+	int* resultado = NULL;
+	if (nivel != NULL && fila != NULL && seguinte != NULL && posicao != NULL && candidatos != NULL
+		&& fronteira != NULL && novos != NULL && visitados != NULL) {
+		int threads = 1;
+#ifdef _OPENMP
+		threads = numThreads > 0 ? numThreads : omp_get_max_threads();
+#else
+		(void)numThreads;
+#endif
+		for (int v = 0; v < n; v++) nivel[v] = -1;
+		int tamanho = 0, alcancados = 0;
+		long long arestasFronteira = 0; // Soma dos graus de saída da fronteira
+		for (int i = 0; i < numSementes; i++) {
+			int v = IndiceGrafoCompacto(gc, sementes[i]);
+			if (v < 0 || nivel[v] == 0) continue;
+			nivel[v] = 0;
+			visitados[v / BITS_PALAVRA] |= 1ULL << (v % BITS_PALAVRA);
+			fila[tamanho++] = v;
+			arestasFronteira += gc->inicioAdj[v + 1] - gc->inicioAdj[v];
+		}
+		long long arestasPorVisitar = gc->numArestas - arestasFronteira; // Arestas de saída dos vértices ainda não visitados
+		bool ascendente = false;
+		for (int profundidade = 1; tamanho > 0; profundidade++) {
+			alcancados += tamanho;
+			// Escolha do sentido do passo (heurística de Beamer)
+			if (!ascendente && arestasFronteira > arestasPorVisitar / ALFA_LARGURA) ascendente = true;
+			else if (ascendente && tamanho < n / BETA_LARGURA) ascendente = false;
+			if (ascendente) {
+				memset(fronteira, 0, numPalavras * sizeof(unsigned long long));
+				for (int i = 0; i < tamanho; i++) fronteira[fila[i] / BITS_PALAVRA] |= 1ULL << (fila[i] % BITS_PALAVRA);
+				tamanho = PassoAscendente(gc, fronteira, novos, seguinte, visitados, nivel, profundidade, numPalavras, threads, &arestasFronteira);
+			}
+			else {
+				tamanho = PassoDescendente(gc, fila, tamanho, seguinte, candidatos, posicao, visitados, nivel, profundidade, threads, &arestasFronteira);
+			}
+			arestasPorVisitar -= arestasFronteira;
+			int* aux = fila; // A nova fronteira passa a ser a atual
+			fila = seguinte;
+			seguinte = aux;
+		}
+		if (numAlcancados != NULL) *numAlcancados = alcancados;
+		resultado = nivel;
+	}
+	else {
+		free(nivel);
+	}
+	free(fila);
+	free(seguinte);
+	free(posicao);
+	free(candidatos);
+	free(fronteira);
+	free(novos);
+	free(visitados);
+	return resultado;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -9,14 +9,32 @@
 #include "../TP_27957_F2/header.h"
 
  /**
-  * Funo principal do programa.
+  * Função principal do programa.
   *
-  * Esta funo cria um grafo, insere vrtices e arestas, busca e mostra o grafo,
-  * encontra e mostra o caminho com a soma mxima de valores no grafo.
+  * Esta função cria um grafo, insere vértices e arestas, busca e mostra o grafo,
+  * encontra e mostra o caminho com a soma máxima de valores no grafo.
+  * Com `--servidor <ficheiro>`, lê a matriz do ficheiro e fica a responder a pedidos lidos de stdin (ver ServirPedidos).
   *
+  * @param argc Número de argumentos da linha de comandos.
+  * @param argv Argumentos da linha de comandos.
   * @return Retorna 0 se o programa for executado com sucesso.
   */
-int main() {
+int main(int argc, char* argv[]) {
+
+	if (argc >= 3 && strcmp(argv[1], "--servidor") == 0) {
+		int resLeitura;
+		Grafo* grafo = LerMatrizDeFicheiro(argv[2], &resLeitura);
+		if (grafo == NULL) {
+			fprintf(stderr, "Não foi possível ler a matriz de %s (%d).\n", argv[2], resLeitura);
+			return 1;
+		}
+		long respondidos = ServirPedidos(grafo, stdin, stdout, 0, 0);
+#ifdef RASTREIO
+		ExportarRastreio("rastreio.json");
+#endif
+		DestruirGrafo(grafo);
+		return respondidos < 0 ? 1 : 0;
+	}
 
 	//int res;
 	//Grafo* g = LerMatrizDeFicheiro("matriz.txt",&res);
@@ -25,7 +43,9 @@ int main() {
 	int res;
 	Grafo* g = CriarGrafo(MAX_VERTICES);
 
-#pragma region CRIAO DE VERTICES
+	RASTREIO_INICIO(inicioVertices);
+
+#pragma region CRIAÇÃO DE VERTICES
 
 	Vertice* v1 = CriarVertice(1, 7);
 	Vertice* v2 = CriarVertice(2, 53);
@@ -55,7 +75,7 @@ int main() {
 
 #pragma endregion
 
-#pragma region INSERO DE VERTICES
+#pragma region INSERÇÃO DE VERTICES
 
 	InserirVerticeGrafo(g, v1, &res);
 	InserirVerticeGrafo(g, v2, &res);
@@ -85,7 +105,10 @@ int main() {
 
 #pragma endregion
 
-#pragma region INSERO DE ADJACENTES
+	RASTREIO_FIM(inicioVertices, "main: inserir vertices");
+	RASTREIO_INICIO(inicioArestas);
+
+#pragma region INSERÇÃO DE ADJACENTES
 
 	// Primeira Linha
 	InserirAdjGrafo(g, 1, 2, &res);
@@ -141,9 +164,14 @@ int main() {
 
 #pragma endregion
 
+	RASTREIO_FIM(inicioArestas, "main: inserir arestas");
+
 	MostrarGrafo(g->inicioGrafo);
-	printf("\nSoma do caminho: %d\n", CalcularSomaCaminho(g, 1, 8));
+	printf("\nSoma do caminho: %lld\n", (long long)CalcularSomaCaminho(g, 1, 8));
 	printf("\n");
 	MostrarSomaMaxima(g);
 	printf("\n");
+#ifdef RASTREIO
+	ExportarRastreio("rastreio.json");
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*********************************************************************
+ * @file   passos.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region PASSOS
+
+#pragma region CaminhoSomaMaximaPassos
+
+ /**
+  * @brief Calcula o caminho de soma máxima com exatamente (ou no máximo) um número de passos a partir de uma origem.
+  *
+  * Programação dinâmica por camadas sobre o número de passos: a melhor soma com que se chega a `v` em `k` passos é o
+  * valor de `v` mais a melhor soma, em `k - 1` passos, dos vértices com arestas para `v` (percorridas nas arestas de
+  * entrada do grafo compacto). Só são guardadas duas camadas de somas, pelo que a memória é proporcional ao número de
+  * vértices; se o caminho for pedido é guardado também, por camada, o antecessor de cada vértice. Os vértices
+  * alcançados em cada camada são marcados à parte (nenhum valor de soma é reservado para "inalcançável"), pelo que
+  * qualquer soma representável em TipoSoma é tratada corretamente.
+  * O ciclo interior é um simples máximo sobre vetores contíguos, que o compilador pode vetorizar.
+  * Em grafos com ciclos um vértice pode aparecer mais do que uma vez no caminho (em grafos acíclicos, como as
+  * grelhas lidas de uma matriz, os caminhos são sempre simples).
+  *
+  * @param g O apontador para o grafo.
+  * @param idOrigem O identificador do vértice de origem.
+  * @param passos O número de passos (arestas) do caminho.
+  * @param ateK Se for `true`, procura o melhor caminho com no máximo `passos` passos (incluindo o caminho só com a origem).
+  * @param comCaminho Se for `true`, o resultado inclui o percurso; caso contrário só a soma e o vértice final.
+  * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+  *        -  1: Caminho encontrado.
+  *        -  0: Não há nenhum caminho com esse número de passos.
+  *        - -1: O vértice de origem não existe ou o número de passos é negativo.
+  *        - -3: Falta de memória.
+  * @return Retorna um apontador para o resultado, a destruir com DestruirResultado, ou NULL se não houver caminho.
+  */
+Resultado* CaminhoSomaMaximaPassos(Grafo* g, IdVertice idOrigem, int passos, bool ateK, bool comCaminho, int* res) {
+	*res = -1;
+	int origem = IndiceVerticeGrafo(g, idOrigem);
+	if (origem < 0 || passos < 0) return NULL;
+	*res = -3;
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	if (gc == NULL) return NULL;
+	int n = gc->numVertices;
+	TipoSoma* anterior = (TipoSoma*)calloc(n + 1, sizeof(TipoSoma)); // Camada k - 1
+	TipoSoma* atual = (TipoSoma*)calloc(n + 1, sizeof(TipoSoma)); // Camada k
+	bool* alcancadoAnterior = (bool*)calloc(n + 1, sizeof(bool)); // Vértices alcançados em k - 1 passos
+	bool* alcancadoAtual = (bool*)calloc(n + 1, sizeof(bool)); // Vértices alcançados em k passos
+	int* pai = comCaminho ? (int*)malloc(((size_t)passos * n + 1) * sizeof(int)) : NULL; // Antecessor de cada vértice em cada camada
+	Resultado* caminho = NULL;
+	if (anterior != NULL && atual != NULL && alcancadoAnterior != NULL && alcancadoAtual != NULL && (pai != NULL || !comCaminho)) {
+		anterior[origem] = gc->valores[origem];
+		alcancadoAnterior[origem] = true;
+		bool soOrigem = ateK || passos == 0; // O caminho só com a origem é um candidato
+		TipoSoma melhorSoma = anterior[origem];
+		int melhorFim = soOrigem ? origem : -1, melhorCamada = 0;
+		for (int k = 1; k <= passos; k++) {
+			bool alcancou = false;
+			for (int v = 0; v < n; v++) {
+				int inicio = gc->inicioAnt[v], fim = gc->inicioAnt[v + 1];
+				TipoSoma maximo = SOMA_MIN;
+				bool algum = false; // Algum antecessor foi alcançado em k - 1 passos
+				for (int a = inicio; a < fim; a++) { // Máximo sem ramificações (vetorizável)
+					int u = gc->origens[a];
+					TipoSoma s = anterior[u];
+					maximo = alcancadoAnterior[u] && s > maximo ? s : maximo;
+					algum |= alcancadoAnterior[u];
+				}
+				alcancadoAtual[v] = algum;
+				if (algum) {
+					atual[v] = maximo + gc->valores[v];
+					alcancou = true;
+					if (pai != NULL) { // O antecessor só é procurado quando o caminho é pedido
+						int a = inicio;
+						while (!alcancadoAnterior[gc->origens[a]] || anterior[gc->origens[a]] != maximo) a++;
+						pai[(size_t)(k - 1) * n + v] = gc->origens[a];
+					}
+				}
+			}
+			if (!alcancou) break; // Nenhum vértice tem caminhos com k passos, nem terá com mais
+			if (ateK || k == passos) {
+				for (int v = 0; v < n; v++) {
+					if (alcancadoAtual[v] && (melhorFim < 0 || atual[v] > melhorSoma)) {
+						melhorSoma = atual[v];
+						melhorFim = v;
+						melhorCamada = k;
+					}
+				}
+			}
+			TipoSoma* aux = anterior; // A camada atual passa a ser a anterior
+			anterior = atual;
+			atual = aux;
+			bool* auxAlcancado = alcancadoAnterior;
+			alcancadoAnterior = alcancadoAtual;
+			alcancadoAtual = auxAlcancado;
+		}
+		*res = 0;
+		if (melhorFim >= 0) {
+			*res = -3;
+			caminho = (Resultado*)malloc(sizeof(Resultado));
+			IdVertice* percurso = comCaminho ? (IdVertice*)malloc((melhorCamada + 1) * sizeof(IdVertice)) : NULL;
+			if (caminho != NULL && (percurso != NULL || !comCaminho)) {
+				if (percurso != NULL) {
+					int v = melhorFim;
+					for (int c = melhorCamada; c > 0; c--) {
+						percurso[c] = gc->ids[v];
+						v = pai[(size_t)(c - 1) * n + v];
+					}
+					percurso[0] = gc->ids[v];
+				}
+				caminho->soma = melhorSoma;
+				caminho->caminho = gc->vertices[melhorFim];
+				caminho->grafo = g;
+				caminho->percurso = percurso;
+				caminho->tamanho = percurso != NULL ? melhorCamada + 1 : 0;
+				caminho->exato = true;
+				*res = 1;
+			}
+			else {
+				free(caminho);
+				free(percurso);
+				caminho = NULL;
+			}
+		}
+	}
+	free(anterior);
+	free(atual);
+	free(alcancadoAnterior);
+	free(alcancadoAtual);
+	free(pai);
+	DestruirGrafoCompacto(gc);
+	return caminho;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
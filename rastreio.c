@@ -0,0 +1,171 @@
+/*********************************************************************
+ * @file   rastreio.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#define CAP_RASTREIO 4096 // Número de eventos guardados por thread (os mais antigos são substituídos)
+
+#ifdef _MSC_VER
+#define LOCAL_THREAD __declspec(thread)
+#else
+#define LOCAL_THREAD _Thread_local
+#endif
+
+#pragma region RASTREIO
+
+// Intervalo de tempo medido, com o nome da fase
+typedef struct EventoRastreio {
+	const char* nome; // Nome da fase (texto constante)
+	double inicio; // Instante de início (ms)
+	double duracao; // Duração (ms)
+} EventoRastreio;
+
+// Buffer circular dos eventos de uma thread
+typedef struct BufferRastreio {
+	EventoRastreio eventos[CAP_RASTREIO];
+	long total; // Número de eventos registados (o evento i está na posição i % CAP_RASTREIO)
+	int thread; // Número da thread no ficheiro exportado
+	struct BufferRastreio* prox; // Buffer da próxima thread
+} BufferRastreio;
+
+static volatile bool rastreioAtivo = true; // Permite desligar o registo sem recompilar
+static BufferRastreio* buffers = NULL; // Buffers de todas as threads que registaram eventos
+static int numBuffers = 0;
+static LOCAL_THREAD BufferRastreio* bufferThread = NULL; // Buffer da thread atual
+
+#pragma region Auxiliares
+
+/**
+ * Obtém o buffer da thread atual, criando-o e registando-o na primeira utilização.
+ */
+static BufferRastreio* BufferAtual() {
+	if (bufferThread != NULL) return bufferThread;
+	BufferRastreio* b = (BufferRastreio*)malloc(sizeof(BufferRastreio));
+	if (b == NULL) return NULL;
+	b->total = 0;
+#pragma omp critical(rastreio)
+	{
+		b->thread = ++numBuffers;
+		b->prox = buffers;
+		buffers = b;
+	}
+	bufferThread = b;
+	return b;
+}
+
+/**
+ * Escreve um texto entre aspas, escapando os caracteres especiais do JSON.
+ */
+static void EscreverTextoJson(FILE* fp, const char* texto) {
+	fputc('"', fp);
+	for (const char* c = texto; *c != '\0'; c++) {
+		if (*c == '"' || *c == '\\') fputc('\\', fp);
+		if ((unsigned char)*c >= ' ') fputc(*c, fp);
+	}
+	fputc('"', fp);
+}
+
+#pragma endregion
+
+#pragma region AtivarRastreio
+
+/**
+ * @brief Liga ou desliga o registo de eventos (só tem efeito quando o programa é compilado com RASTREIO).
+ *
+ * @param ativo `true` para registar os eventos, `false` para os ignorar.
+ */
+void AtivarRastreio(bool ativo) {
+	rastreioAtivo = ativo;
+}
+
+#pragma endregion
+
+#pragma region InicioRastreio
+
+/**
+ * @brief Marca o início de uma fase rastreada (usada pela macro RASTREIO_INICIO).
+ *
+ * @return O instante atual em milissegundos, ou -1 se o rastreio estiver desligado.
+ */
+double InicioRastreio() {
+	return rastreioAtivo ? TempoAtualMs() : -1;
+}
+
+#pragma endregion
+
+#pragma region FimRastreio
+
+/**
+ * @brief Regista uma fase rastreada no buffer da thread atual (usada pela macro RASTREIO_FIM).
+ *
+ * Cada thread escreve só no seu buffer circular, sem sincronização; quando o buffer está cheio o evento
+ * mais antigo é substituído.
+ *
+ * @param nome O nome da fase (tem de ser um texto constante, que não é copiado).
+ * @param inicio O instante de início devolvido por InicioRastreio (se for negativo, o evento é ignorado).
+ */
+void FimRastreio(const char* nome, double inicio) {
+	if (inicio < 0) return;
+	double fim = TempoAtualMs();
+	BufferRastreio* b = BufferAtual();
+	if (b == NULL) return;
+	EventoRastreio* e = &b->eventos[b->total % CAP_RASTREIO];
+	e->nome = nome;
+	e->inicio = inicio;
+	e->duracao = fim - inicio;
+	b->total++;
+}
+
+#pragma endregion
+
+#pragma region ExportarRastreio
+
+/**
+ * @brief Escreve os eventos registados num ficheiro no formato JSON de eventos do Chrome (chrome://tracing, Perfetto).
+ *
+ * Deve ser chamada quando nenhuma thread estiver a registar eventos.
+ *
+ * @param nomeFicheiro O caminho do ficheiro a criar.
+ * @return O número de eventos escritos, ou -1 se não foi possível criar o ficheiro.
+ */
+long ExportarRastreio(const char* nomeFicheiro) {
+	FILE* fp = fopen(nomeFicheiro, "w");
+	if (fp == NULL) return -1;
+	long escritos = 0;
+	fprintf(fp, "{\"traceEvents\":[");
+	for (BufferRastreio* b = buffers; b != NULL; b = b->prox) {
+		long primeiro = b->total > CAP_RASTREIO ? b->total - CAP_RASTREIO : 0;
+		for (long i = primeiro; i < b->total; i++) {
+			EventoRastreio* e = &b->eventos[i % CAP_RASTREIO];
+			fprintf(fp, "%s\n{\"name\":", escritos > 0 ? "," : "");
+			EscreverTextoJson(fp, e->nome);
+			fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}", e->inicio * 1000.0, e->duracao * 1000.0, b->thread);
+			escritos++;
+		}
+	}
+	fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+	fclose(fp);
+	return escritos;
+}
+
+#pragma endregion
+
+#pragma region LimparRastreio
+
+/**
+ * @brief Descarta os eventos registados por todas as threads (os buffers são reutilizados).
+ *
+ * Deve ser chamada quando nenhuma thread estiver a registar eventos.
+ */
+void LimparRastreio() {
+	for (BufferRastreio* b = buffers; b != NULL; b = b->prox) b->total = 0;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
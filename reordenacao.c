@@ -0,0 +1,246 @@
+/*********************************************************************
+ * @file   reordenacao.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region REORDENACAO
+
+#pragma region Auxiliares
+
+// Vizinhança não dirigida de um grafo (arestas de saída e de entrada), no formato de linhas comprimidas
+typedef struct Vizinhanca {
+	int* inicio; // Posição em "vizinhos" do primeiro vizinho de cada índice (n + 1 posições)
+	int* vizinhos; // Índices dos vizinhos de todos os vértices
+} Vizinhanca;
+
+/**
+ * Constrói a vizinhança não dirigida de um grafo compacto, juntando a cada vértice os destinos das suas
+ * arestas e as origens das arestas que chegam a ele.
+ */
+static bool CriarVizinhanca(GrafoCompacto* gc, Vizinhanca* viz) {
+	int n = gc->numVertices;
+	viz->inicio = (int*)calloc(n + 2, sizeof(int));
+	viz->vizinhos = (int*)malloc((2 * gc->numArestas + 1) * sizeof(int));
+	if (viz->inicio == NULL || viz->vizinhos == NULL) {
+		free(viz->inicio);
+		free(viz->vizinhos);
+		return false;
+	}
+	for (int v = 0; v < n; v++) {
+		for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+			viz->inicio[v + 2]++;
+			viz->inicio[gc->destinos[k] + 2]++;
+		}
+	}
+	for (int v = 0; v < n; v++) viz->inicio[v + 2] += viz->inicio[v + 1];
+	for (int v = 0; v < n; v++) { // "inicio[v + 1]" serve de posição de escrita e acaba no início de v + 1
+		for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+			int w = gc->destinos[k];
+			viz->vizinhos[viz->inicio[v + 1]++] = w;
+			viz->vizinhos[viz->inicio[w + 1]++] = v;
+		}
+	}
+	return true;
+}
+
+/**
+ * Ordena um troço de índices por grau crescente (ordenação por inserção: os troços são pequenos).
+ */
+static void OrdenarPorGrau(int* indices, int tamanho, Vizinhanca* viz) {
+	for (int i = 1; i < tamanho; i++) {
+		int v = indices[i];
+		int grau = viz->inicio[v + 1] - viz->inicio[v];
+		int j = i;
+		while (j > 0 && viz->inicio[indices[j - 1] + 1] - viz->inicio[indices[j - 1]] > grau) {
+			indices[j] = indices[j - 1];
+			j--;
+		}
+		indices[j] = v;
+	}
+}
+
+#pragma endregion
+
+#pragma region CalcularOrdemVertices
+
+/**
+ * @brief Calcula uma ordem dos vértices que aproxima em memória os vértices vizinhos.
+ *
+ * - ORDEM_LARGURA: procura em largura sobre as arestas nos dois sentidos, começando em cada componente
+ *   pelo vértice de menor identificador;
+ * - ORDEM_CUTHILL_MCKEE: procura em largura que começa em cada componente pelo vértice de menor grau e visita
+ *   os vizinhos por grau crescente, sendo a ordem final invertida (Cuthill-McKee inversa);
+ * - ORDEM_IDENTIFICADOR: ordem crescente dos identificadores, que nas grelhas lidas de uma matriz é a ordem por linhas.
+ *
+ * @param g Apontador para o grafo.
+ * @param criterio O critério de ordenação.
+ * @return Vetor com os índices densos atuais pela nova ordem (a libertar com `free`), ou `NULL` se o grafo
+ *         for nulo ou se a alocação de memória falhar.
+ */
+int* CalcularOrdemVertices(Grafo* g, OrdemVertices criterio) {
+	if (g == NULL) return NULL;
+	int n = g->numVertices;
+	int* ordem = (int*)malloc((n + 1) * sizeof(int));
+	if (ordem == NULL) return NULL;
+	// Os vértices de partida são considerados pela ordem da lista (crescente por identificador)
+	int k = 0;
+	for (Vertice* v = g->inicioGrafo; v != NULL && k < n; v = v->proxVertice) ordem[k++] = v->indice;
+	if (criterio == ORDEM_IDENTIFICADOR || n == 0) return ordem;
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	Vizinhanca viz = { NULL, NULL };
+	int* partidas = (int*)malloc((n + 1) * sizeof(int));
+	bool* visitado = (bool*)calloc(n + 1, sizeof(bool));
+	if (gc == NULL || partidas == NULL || visitado == NULL || !CriarVizinhanca(gc, &viz)) {
+		DestruirGrafoCompacto(gc);
+		free(partidas);
+		free(visitado);
+		free(ordem);
+		return NULL;
+	}
+	memcpy(partidas, ordem, n * sizeof(int));
+	if (criterio == ORDEM_CUTHILL_MCKEE) {
+		// Partidas por grau crescente (ordenação por contagem, estável em relação aos identificadores)
+		int maiorGrau = 0;
+		for (int v = 0; v < n; v++) {
+			int grau = viz.inicio[v + 1] - viz.inicio[v];
+			if (grau > maiorGrau) maiorGrau = grau;
+		}
+		int* contagem = (int*)calloc(maiorGrau + 2, sizeof(int));
+		if (contagem != NULL) {
+			for (int v = 0; v < n; v++) contagem[viz.inicio[v + 1] - viz.inicio[v] + 1]++;
+			for (int d = 0; d <= maiorGrau; d++) contagem[d + 1] += contagem[d];
+			for (int i = 0; i < n; i++) {
+				int v = ordem[i];
+				partidas[contagem[viz.inicio[v + 1] - viz.inicio[v]]++] = v;
+			}
+			free(contagem);
+		}
+	}
+	// Procura em largura; a própria ordem serve de fila
+	int fim = 0;
+	for (int i = 0; i < n; i++) {
+		int raiz = partidas[i];
+		if (visitado[raiz]) continue;
+		int cabeca = fim;
+		visitado[raiz] = true;
+		ordem[fim++] = raiz;
+		while (cabeca < fim) {
+			int v = ordem[cabeca++];
+			int primeiro = fim;
+			for (int j = viz.inicio[v]; j < viz.inicio[v + 1]; j++) {
+				int w = viz.vizinhos[j];
+				if (!visitado[w]) {
+					visitado[w] = true;
+					ordem[fim++] = w;
+				}
+			}
+			if (criterio == ORDEM_CUTHILL_MCKEE) OrdenarPorGrau(ordem + primeiro, fim - primeiro, &viz);
+		}
+	}
+	if (criterio == ORDEM_CUTHILL_MCKEE) {
+		for (int i = 0; i < n / 2; i++) {
+			int aux = ordem[i];
+			ordem[i] = ordem[n - 1 - i];
+			ordem[n - 1 - i] = aux;
+		}
+	}
+	free(viz.inicio);
+	free(viz.vizinhos);
+	free(partidas);
+	free(visitado);
+	DestruirGrafoCompacto(gc);
+	return ordem;
+}
+
+#pragma endregion
+
+#pragma region ReordenarGrafo
+
+/**
+ * @brief Reorganiza os vértices e as adjacências de um grafo em memória contígua, pela ordem indicada.
+ *
+ * Esta função copia todos os vértices para um único bloco, pela ordem calculada por CalcularOrdemVertices,
+ * e as adjacências de cada vértice para um segundo bloco, logo a seguir às do vértice anterior. Os índices
+ * densos passam a ser as posições no bloco, pelo que também os vetores auxiliares das pesquisas ficam pela
+ * nova ordem. A lista de vértices continua ordenada por identificador (só muda a posição dos nós em memória).
+ * Os nós antigos são libertados; os apontadores para vértices obtidos antes da reordenação deixam de ser válidos.
+ * Os vértices inseridos depois continuam a ser alocados individualmente, e o vetor de adjacências de um vértice
+ * passa a ter memória própria na primeira inserção que o faça crescer.
+ *
+ * @param g Apontador para o grafo a reorganizar.
+ * @param criterio O critério de ordenação dos vértices.
+ * @param res Apontador para uma variável booleana que será definida como verdadeira se a operação for bem-sucedida.
+ * @return Retorna um apontador para o grafo reorganizado (inalterado se a operação falhar).
+ */
+Grafo* ReordenarGrafo(Grafo* g, OrdemVertices criterio, bool* res) {
+	*res = false;
+	if (g == NULL) return NULL;
+	int n = g->numVertices;
+	int m = 0;
+	for (int i = 0; i < n; i++) {
+		m += g->porIndice[i]->numAdjacentes;
+	}
+	int* ordem = CalcularOrdemVertices(g, criterio);
+	int* posicao = (int*)malloc((n + 1) * sizeof(int)); // Nova posição de cada índice denso atual
+	Vertice* blocoVertices = (Vertice*)malloc((n + 1) * sizeof(Vertice));
+	IdVertice* blocoAdjacentes = (IdVertice*)malloc((m + 1) * sizeof(IdVertice));
+	if (ordem == NULL || posicao == NULL || blocoVertices == NULL || blocoAdjacentes == NULL) {
+		free(ordem);
+		free(posicao);
+		free(blocoVertices);
+		free(blocoAdjacentes);
+		return g;
+	}
+	// Copiar os vértices e as suas adjacências para os blocos, pela nova ordem
+	int proxAdj = 0;
+	for (int k = 0; k < n; k++) {
+		Vertice* antigo = g->porIndice[ordem[k]];
+		Vertice* novo = &blocoVertices[k];
+		posicao[ordem[k]] = k;
+		*novo = *antigo;
+		novo->indice = k;
+		novo->emBloco = true;
+		novo->adjacentes = &blocoAdjacentes[proxAdj];
+		novo->capAdjacentes = antigo->numAdjacentes; // Sem espaço livre: a próxima inserção copia o vetor para memória própria
+		novo->adjEmBloco = true;
+		if (antigo->numAdjacentes > 0) memcpy(novo->adjacentes, antigo->adjacentes, antigo->numAdjacentes * sizeof(IdVertice));
+		proxAdj += antigo->numAdjacentes;
+	}
+	// Refazer a lista de vértices (ordenada por identificador) com os novos nós
+	Vertice* anterior = NULL;
+	for (Vertice* v = g->inicioGrafo; v != NULL; v = v->proxVertice) {
+		Vertice* novo = &blocoVertices[posicao[v->indice]];
+		novo->proxVertice = NULL;
+		novo->antVertice = anterior;
+		if (anterior == NULL) g->inicioGrafo = novo;
+		else anterior->proxVertice = novo;
+		anterior = novo;
+	}
+	g->fimGrafo = anterior;
+	// Libertar os nós antigos (os que estavam num bloco anterior são libertados com o bloco)
+	for (int i = 0; i < n; i++) {
+		DestruirVertice(g->porIndice[i]);
+	}
+	free(g->blocoVertices);
+	free(g->blocoAdjacentes);
+	g->blocoVertices = blocoVertices;
+	g->blocoAdjacentes = blocoAdjacentes;
+	// Atualizar os índices densos
+	for (int k = 0; k < n; k++) {
+		g->porIndice[k] = &blocoVertices[k];
+		InserirTabelaIds(&g->ids, blocoVertices[k].id, k);
+	}
+	free(ordem);
+	free(posicao);
+	*res = true;
+	return g;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,241 @@
+/*********************************************************************
+ * @file   servidor.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define MAX_LINHA_PEDIDO 256 // Número máximo de caracteres de um pedido
+
+#pragma region SERVIDOR
+
+// Tipos de pedido aceites pelo servidor
+typedef enum TipoPedido {
+	PEDIDO_SOMA, // soma <origem> <destino>: soma dos valores do caminho com menos arestas
+	PEDIDO_ALCANCA, // alcanca <origem> <destino>: se o destino é alcançável e com quantas arestas
+	PEDIDO_MAXIMA, // maxima <origem> <destino>: caminho simples de soma máxima
+	PEDIDO_VALOR, // valor <id> <valor>: altera o valor de um vértice
+	PEDIDO_CELULA, // celula <linha> <coluna> <valor>: altera o valor de uma célula da matriz
+	PEDIDO_INVALIDO // Pedido que não foi reconhecido
+} TipoPedido;
+
+// Pedido de um lote, com os argumentos e a resposta
+typedef struct Pedido {
+	TipoPedido tipo;
+	long long args[3]; // Argumentos do pedido
+	int res; // Resultado da operação (códigos das funções chamadas)
+	TipoSoma soma; // Soma do caminho encontrado
+	int arestas; // Número de arestas do caminho encontrado
+	Resultado* caminho; // Caminho de soma máxima (só nos pedidos "maxima")
+	double chegada; // Instante em que o pedido foi lido (ms)
+	double fim; // Instante em que a resposta ficou pronta (ms)
+} Pedido;
+
+#pragma region Auxiliares
+
+/**
+ * Converte uma linha de texto num pedido. Devolve false se a linha estiver vazia (fim do lote).
+ */
+static bool LerPedido(const char* linha, Pedido* p) {
+	char nome[16];
+	int lidos = sscanf(linha, "%15s %lld %lld %lld", nome, &p->args[0], &p->args[1], &p->args[2]);
+	if (lidos < 1) return false;
+	p->tipo = PEDIDO_INVALIDO;
+	if (strcmp(nome, "soma") == 0 && lidos == 3) p->tipo = PEDIDO_SOMA;
+	else if (strcmp(nome, "alcanca") == 0 && lidos == 3) p->tipo = PEDIDO_ALCANCA;
+	else if (strcmp(nome, "maxima") == 0 && lidos == 3) p->tipo = PEDIDO_MAXIMA;
+	else if (strcmp(nome, "valor") == 0 && lidos == 3) p->tipo = PEDIDO_VALOR;
+	else if (strcmp(nome, "celula") == 0 && lidos == 4) p->tipo = PEDIDO_CELULA;
+	p->res = -2;
+	p->caminho = NULL;
+	return true;
+}
+
+/**
+ * Verifica se um pedido altera o grafo (e tem por isso de ser executado sozinho, pela ordem de chegada).
+ */
+static bool PedidoEscrita(Pedido* p) {
+	return p->tipo == PEDIDO_VALOR || p->tipo == PEDIDO_CELULA;
+}
+
+/**
+ * Executa um pedido de leitura sobre a cópia compacta do grafo, com o estado de pesquisa da thread.
+ */
+static void ExecutarLeitura(GrafoCompacto* gc, PesquisaBidirecional* pesquisa, Pedido* p) {
+	RASTREIO_INICIO(inicio);
+	if (p->tipo == PEDIDO_SOMA || p->tipo == PEDIDO_ALCANCA) {
+		Resultado* r = CaminhoBidirecional(pesquisa, p->args[0], p->args[1], &p->res);
+		if (r != NULL) {
+			p->soma = r->soma;
+			p->arestas = r->tamanho - 1;
+			DestruirResultado(r);
+		}
+	}
+	else if (p->tipo == PEDIDO_MAXIMA) {
+		p->caminho = CaminhoSomaMaximaEntreCompacto(gc, p->args[0], p->args[1], &p->res);
+	}
+	RASTREIO_FIM(inicio, p->tipo == PEDIDO_MAXIMA ? "ServirPedidos: maxima" : "ServirPedidos: soma/alcanca");
+	p->fim = TempoAtualMs();
+}
+
+/**
+ * Executa um pedido de escrita, atualizando também a cópia compacta usada pelas pesquisas.
+ */
+static void ExecutarEscrita(Grafo* g, GrafoCompacto* gc, Pedido* p) {
+	// A posição da célula é validada antes de ser convertida, porque -1 também é um identificador válido
+	bool posicaoValida = p->tipo != PEDIDO_CELULA || (p->args[0] >= 0 && p->args[0] <= INT_MAX && p->args[1] >= 0
+		&& p->args[1] <= INT_MAX && ExisteCelulaGrelha(g, (int)p->args[0], (int)p->args[1]));
+	long long valor = p->tipo == PEDIDO_CELULA ? p->args[2] : p->args[1];
+	p->res = -1;
+	if (posicaoValida && valor >= VALOR_MIN && valor <= VALOR_MAX) {
+		IdVertice id = p->tipo == PEDIDO_CELULA ? IdCelulaGrelha(g, (int)p->args[0], (int)p->args[1]) : p->args[0];
+		bool alterado;
+		AlterarValorVerticeGrafo(g, id, (TipoValor)valor, &alterado);
+		if (alterado) {
+			AlterarValorGrafoCompacto(gc, IndiceGrafoCompacto(gc, id), (TipoValor)valor); // Os valores mudam, mas as arestas não
+			p->res = 1;
+		}
+	}
+	p->fim = TempoAtualMs();
+}
+
+/**
+ * Escreve a resposta de um pedido: número do pedido, estado, resultado e latência (ms).
+ */
+static void EscreverResposta(FILE* saida, long numero, Pedido* p) {
+	fprintf(saida, "%ld ", numero);
+	if (p->res < 0) fprintf(saida, "erro %d", p->res);
+	else if (p->tipo == PEDIDO_ALCANCA) {
+		if (p->res == 1) fprintf(saida, "ok sim %d", p->arestas);
+		else fprintf(saida, "ok nao");
+	}
+	else if (p->res == 0) fprintf(saida, "ok sem-caminho");
+	else if (p->tipo == PEDIDO_SOMA) fprintf(saida, "ok %lld", (long long)p->soma);
+	else if (p->tipo == PEDIDO_MAXIMA) {
+		fprintf(saida, "ok %lld", (long long)p->caminho->soma);
+		for (int i = 0; i < p->caminho->tamanho; i++) fprintf(saida, "%c%lld", i == 0 ? ' ' : ',', p->caminho->percurso[i]);
+	}
+	else fprintf(saida, "ok");
+	fprintf(saida, " %.3fms\n", p->fim - p->chegada);
+	DestruirResultado(p->caminho);
+	p->caminho = NULL;
+}
+
+#pragma endregion
+
+#pragma region ServirPedidos
+
+/**
+ * @brief Responde a pedidos sobre um grafo residente em memória, lidos de um canal de texto (por exemplo, stdin).
+ *
+ * Protocolo de linhas: cada linha é um pedido (`soma o d`, `alcanca o d`, `maxima o d`, `valor id v`,
+ * `celula l c v`) e cada resposta é uma linha `<número> ok <resultado> <latência>ms` ou `<número> erro <código>
+ * <latência>ms`, pela ordem dos pedidos. Os pedidos são tratados por lotes: o servidor lê até `tamanhoLote` pedidos
+ * (uma linha vazia fecha o lote mais cedo, para uso interativo), executa os pedidos de leitura entre duas escritas
+ * em paralelo (cada thread com o seu estado de pesquisa bidirecional, sobre uma cópia compacta do grafo), executa as
+ * escritas pela ordem de chegada e só então escreve as respostas do lote. A latência de cada pedido vai do momento
+ * em que foi lido até ao momento em que a resposta ficou pronta. O servidor termina no fim da entrada ou com `fim`,
+ * escrevendo uma linha de resumo começada por '#'.
+ *
+ * Atenção: `maxima` usa CaminhoSomaMaximaEntreCompacto, que é linear quando os vértices que alcançam o destino não
+ * formam ciclos, mas que num grafo com ciclos faz uma pesquisa exponencial sem limite de tempo; um pedido desses
+ * atrasa todo o lote em que está. Nesses grafos `maxima` só deve ser usado entre vértices próximos (as matrizes lidas
+ * de ficheiro, só com arestas para a direita e para baixo, não têm ciclos).
+ *
+ * @param g O apontador para o grafo.
+ * @param entrada O canal de onde são lidos os pedidos.
+ * @param saida O canal onde são escritas as respostas.
+ * @param tamanhoLote Número máximo de pedidos por lote (0 para 64).
+ * @param numThreads Número de threads (0 para o número por omissão).
+ * @return O número de pedidos respondidos, ou -1 se o grafo ou os canais forem nulos, ou -3 se faltar memória.
+ */
+long ServirPedidos(Grafo* g, FILE* entrada, FILE* saida, int tamanhoLote, int numThreads) {
+	if (g == NULL || entrada == NULL || saida == NULL) return -1;
+	if (tamanhoLote <= 0) tamanhoLote = 64;
+	int threads = 1;
+#ifdef _OPENMP
+	threads = numThreads > 0 ? numThreads : omp_get_max_threads();
+#else
+	(void)numThreads;
+#endif
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	Pedido* lote = (Pedido*)malloc(tamanhoLote * sizeof(Pedido));
+	PesquisaBidirecional** pesquisas = (PesquisaBidirecional**)calloc(threads, sizeof(PesquisaBidirecional*));
+	bool ok = gc != NULL && lote != NULL && pesquisas != NULL;
+	for (int t = 0; t < threads && ok; t++) {
+		pesquisas[t] = CriarPesquisaBidirecional(gc);
+		if (pesquisas[t] == NULL) ok = false;
+	}
+	long respondidos = ok ? 0 : -3;
+	double somaLatencias = 0, maiorLatencia = 0;
+	char linha[MAX_LINHA_PEDIDO];
+	bool terminar = !ok;
+	while (!terminar) {
+		// Leitura do lote
+		int tamanho = 0;
+		while (tamanho < tamanhoLote) {
+			if (fgets(linha, sizeof(linha), entrada) == NULL) {
+				terminar = true;
+				break;
+			}
+			if (strncmp(linha, "fim", 3) == 0 && (linha[3] == '\n' || linha[3] == '\r' || linha[3] == '\0')) {
+				terminar = true;
+				break;
+			}
+			if (!LerPedido(linha, &lote[tamanho])) {
+				if (tamanho > 0) break; // Linha vazia: fecha o lote
+				continue;
+			}
+			lote[tamanho++].chegada = TempoAtualMs();
+		}
+		// Execução: leituras em paralelo, entre escritas executadas pela ordem de chegada
+		RASTREIO_INICIO(inicioLote);
+		for (int inicio = 0; inicio < tamanho; ) {
+			if (PedidoEscrita(&lote[inicio])) {
+				ExecutarEscrita(g, gc, &lote[inicio]);
+				inicio++;
+				continue;
+			}
+			int fim = inicio;
+			while (fim < tamanho && !PedidoEscrita(&lote[fim])) fim++;
+#pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+			for (int i = inicio; i < fim; i++) {
+				int t = 0;
+#ifdef _OPENMP
+				t = omp_get_thread_num();
+#endif
+				ExecutarLeitura(gc, pesquisas[t], &lote[i]);
+			}
+			inicio = fim;
+		}
+		RASTREIO_FIM(inicioLote, "ServirPedidos: executar lote");
+		// Respostas, pela ordem dos pedidos
+		for (int i = 0; i < tamanho; i++) {
+			double latencia = lote[i].fim - lote[i].chegada;
+			somaLatencias += latencia;
+			if (latencia > maiorLatencia) maiorLatencia = latencia;
+			EscreverResposta(saida, ++respondidos, &lote[i]);
+		}
+		fflush(saida);
+	}
+	if (respondidos >= 0) {
+		fprintf(saida, "# %ld pedidos, latencia media %.3fms, maxima %.3fms\n", respondidos,
+			respondidos > 0 ? somaLatencias / respondidos : 0.0, maiorLatencia);
+		fflush(saida);
+	}
+	for (int t = 0; pesquisas != NULL && t < threads; t++) DestruirPesquisaBidirecional(pesquisas[t]);
+	free(pesquisas);
+	free(lote);
+	DestruirGrafoCompacto(gc);
+	return respondidos;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -13,18 +13,18 @@
 #pragma region AtualizarResultado
 
  /**
-  * Funo para atualizar um resultado com base em uma nova soma e caminho.
+  * Função para atualizar um resultado com base em uma nova soma e caminho.
   *
-  * Esta funo atualiza um resultado com base em uma nova soma e caminho encontrados durante
-  * a anlise de um grafo. Se a soma atual for maior que a soma armazenada no resultado, a soma
-  * e o caminho no resultado so atualizados com os valores fornecidos.
+  * Esta função atualiza um resultado com base em uma nova soma e caminho encontrados durante
+  * a análise de um grafo. Se a soma atual for maior que a soma armazenada no resultado, a soma
+  * e o caminho no resultado são atualizados com os valores fornecidos.
   *
   * @param res O apontador para o resultado a ser atualizado.
   * @param somaAtual A soma atual a ser comparada com a soma armazenada no resultado.
-  * @param caminhoAtual O apontador para o vrtice representando o caminho atual a ser armazenado no resultado.
-  * @return Retorna 0 se a atualizao for bem-sucedida, caso contrrio, retorna -1.
+  * @param caminhoAtual O apontador para o vértice representando o caminho atual a ser armazenado no resultado.
+  * @return Retorna 0 se a atualização for bem-sucedida, caso contrário, retorna -1.
   */
-int AtualizarResultado(Resultado* res, int somaAtual, Vertice* caminhoAtual) {
+int AtualizarResultado(Resultado* res, TipoSoma somaAtual, Vertice* caminhoAtual) {
 	if (res == NULL) return -1;
 	if (somaAtual > res->soma) { // Comparar a soma atual com a soma armazenada no resultado
 		res->soma = somaAtual; // Atualizar a soma no resultado
@@ -38,39 +38,37 @@ int AtualizarResultado(Resultado* res, int somaAtual, Vertice* caminhoAtual) {
 #pragma region BuscarCaminhoMaximo
 
 /**
- * Funo para buscar o caminho mximo em um grafo a partir de um vrtice dado.
- *
- * Esta funo realiza uma busca em profundidade a partir de um vrtice em um grafo, buscando
- * encontrar o caminho mximo (com a maior soma de valores dos vrtices) possvel. Ela marca os
- * vrtices visitados durante a busca, atualiza o resultado com o caminho mximo encontrado e
- * continua a busca pelos vrtices adjacentes no visitados. Aps a concluso da busca em profundidade
- * a partir de um vrtice, ele  desmarcado como visitado para permitir outras buscas.
- *
- * @param v O vrtice inicial da busca.
- * @param somaAtual A soma acumulada dos valores dos vrtices ao longo do caminho atual.
- * @param res O apontador para o resultado onde o caminho mximo ser armazenado.
- * @return Retorna 0 aps concluir a busca em profundidade a partir do vrtice dado.
- *         Retorna -1 se o vrtice dado for nulo.
+ * Função para buscar o caminho máximo em um grafo a partir de um vértice dado.
+ *
+ * Esta função realiza uma busca em profundidade a partir de um vértice em um grafo, buscando
+ * encontrar o caminho máximo (com a maior soma de valores dos vértices) possível. Ela marca os
+ * vértices visitados durante a busca, atualiza o resultado com o caminho máximo encontrado e
+ * continua a busca pelos vértices adjacentes não visitados. Após a conclusão da busca em profundidade
+ * a partir de um vértice, ele é desmarcado como visitado para permitir outras buscas.
+ *
+ * @param v O vértice inicial da busca.
+ * @param somaAtual A soma acumulada dos valores dos vértices ao longo do caminho atual.
+ * @param res O apontador para o resultado onde o caminho máximo será armazenado.
+ * @return Retorna 0 após concluir a busca em profundidade a partir do vértice dado.
+ *         Retorna -1 se o vértice dado for nulo.
  */
-int BuscarCaminhoMaximo(Vertice* v, int somaAtual, Resultado* res) {
+int BuscarCaminhoMaximo(Vertice* v, TipoSoma somaAtual, Resultado* res) {
 	if (v == NULL) {
 		return -1;
 	}
-	// Marcar o vrtice como visitado
+	// Marcar o vértice como visitado
 	v->visitado = true;
 	somaAtual += v->valor;
 	// Atualizar o resultado se a soma atual for maior
 	AtualizarResultado(res, somaAtual, v);
-	// Recorrer os vrtices adjacentes
-	Adjacente* adj = v->proxAdjacente;
-	while (adj != NULL) {
-		Vertice* verticeAdjacente = OndeEstaVerticeGrafo(res->grafo, adj->id);
+	// Recorrer os vértices adjacentes
+	for (int i = 0; i < v->numAdjacentes; i++) {
+		Vertice* verticeAdjacente = OndeEstaVerticeGrafo(res->grafo, v->adjacentes[i]);
 		if (verticeAdjacente != NULL && !verticeAdjacente->visitado) {
 			BuscarCaminhoMaximo(verticeAdjacente, somaAtual, res); // Continuar a busca em profundidade
 		}
-		adj = adj->proximo;
 	}
-	// Desmarcar o vrtice como visitado para permitir outras buscas
+	// Desmarcar o vértice como visitado para permitir outras buscas
 	v->visitado = false;
 	return 0;
 }
@@ -80,17 +78,18 @@ int BuscarCaminhoMaximo(Vertice* v, int somaAtual, Resultado* res) {
 #pragma region CaminhoSomaMaxima
 
 /**
- * Funo para encontrar o caminho com a soma mxima de valores em um grafo.
+ * Função para encontrar o caminho com a soma máxima de valores em um grafo.
  *
- * Esta funo percorre todos os vrtices de um grafo, realizando uma busca em profundidade a partir de cada vrtice
- * para encontrar o caminho com a soma mxima de valores. Ela utiliza a funo BuscarCaminhoMaximo para buscar o caminho
- * mximo a partir de cada vrtice e atualiza o resultado com o caminho mximo encontrado.
+ * Esta função percorre todos os vértices de um grafo, realizando uma busca em profundidade a partir de cada vértice
+ * para encontrar o caminho com a soma máxima de valores. Ela utiliza a função BuscarCaminhoMaximo para buscar o caminho
+ * máximo a partir de cada vértice e atualiza o resultado com o caminho máximo encontrado.
  *
- * @param g O apontador para o grafo onde o caminho com a soma mxima ser procurado.
- * @return Retorna um apontador para o resultado contendo o caminho com a soma mxima de valores.
- *         Retorna NULL se no for possvel alocar memria para o resultado.
+ * @param g O apontador para o grafo onde o caminho com a soma máxima será procurado.
+ * @return Retorna um apontador para o resultado contendo o caminho com a soma máxima de valores.
+ *         Retorna NULL se não for possível alocar memória para o resultado.
  */
 Resultado* CaminhoSomaMaxima(Grafo* g) {
+	RASTREIO_INICIO(inicio);
 	Resultado* res = (Resultado*)malloc(sizeof(Resultado));
 	if (res == NULL) {
 		return NULL;
@@ -98,11 +97,15 @@ Resultado* CaminhoSomaMaxima(Grafo* g) {
 	res->soma = 0;
 	res->caminho = NULL;
 	res->grafo = g;
-	Vertice* v = g->inicioGrafo; // Iniciar a busca a partir do primeiro vrtice do grafo
+	res->percurso = NULL;
+	res->tamanho = 0;
+	res->exato = true;
+	Vertice* v = g->inicioGrafo; // Iniciar a busca a partir do primeiro vértice do grafo
 	while (v != NULL) {
-		BuscarCaminhoMaximo(v, 0, res); // Buscar o caminho mximo a partir do vrtice atual
-		v = v->proxVertice; // Avanar para o prximo vrtice
+		BuscarCaminhoMaximo(v, 0, res); // Buscar o caminho máximo a partir do vértice atual
+		v = v->proxVertice; // Avançar para o próximo vértice
 	}
+	RASTREIO_FIM(inicio, "CaminhoSomaMaxima");
 	return res;
 }
 
@@ -111,28 +114,432 @@ Resultado* CaminhoSomaMaxima(Grafo* g) {
 #pragma region MostrarSomaMaxima
 
 /**
- * Funo para mostrar o caminho com a soma mxima de valores em um grafo.
+ * Função para mostrar o caminho com a soma máxima de valores em um grafo.
  *
- * Esta funo imprime na sada padro a soma mxima de valores encontrada no grafo e o caminho associado a essa soma mxima.
- * Ela utiliza a funo CaminhoSomaMaxima para encontrar o resultado contendo o caminho com a soma mxima e imprime
- * os detalhes desse caminho na sada padro.
+ * Esta função imprime na saída padrão a soma máxima de valores encontrada no grafo e o caminho associado a essa soma máxima.
+ * Ela utiliza a função CaminhoSomaMaxima para encontrar o resultado contendo o caminho com a soma máxima e imprime
+ * os detalhes desse caminho na saída padrão.
  *
- * @param grafo O apontador para o grafo onde o caminho com a soma mxima ser procurado e exibido.
+ * @param grafo O apontador para o grafo onde o caminho com a soma máxima será procurado e exibido.
  */
 void MostrarSomaMaxima(Grafo* grafo) {
-	Resultado* res = CaminhoSomaMaxima(grafo); // Encontrar o caminho com a soma mxima
-	if (res == NULL) return NULL;
-	Vertice* caminho = res->caminho;
-	printf("Soma Maxima: %d\n", res->soma);
-	printf("Caminho: ");
-	while (caminho != NULL) {
-		printf("%d(%d)\t", caminho->id, caminho->valor);
-		caminho = caminho->proxVertice;
-	}
-	printf("\n");
+	Resultado* res = CaminhoSomaMaxima(grafo); // Encontrar o caminho com a soma máxima
+	if (res == NULL) return;
+	SaidaExportacao* s = CriarSaidaPadrao();
+	if (s != NULL) {
+		ExportarResultado(s, res);
+		DestruirSaidaExportacao(s);
+	}
+	DestruirResultado(res);
+}
+
+#pragma endregion
+
+#pragma region DestruirResultado
+
+/**
+ * Função para libertar a memória associada a um resultado.
+ *
+ * Esta função liberta o percurso guardado no resultado (se existir) e o próprio resultado.
+ * O grafo associado ao resultado não é destruído.
+ *
+ * @param res O apontador para o resultado a ser destruído.
+ */
+void DestruirResultado(Resultado* res) {
+	if (res == NULL) return;
+	free(res->percurso);
 	free(res);
 }
 
 #pragma endregion
 
+#pragma region CaminhoSomaMaximaLimitado
+
+// Estado partilhado pelas chamadas recursivas de uma pesquisa limitada
+typedef struct PesquisaLimitada {
+	Resultado* res; // Melhor resultado encontrado até ao momento
+	LimitesPesquisa* limites; // Limites de tempo e de vértices expandidos
+	EstatisticasPesquisa* estat; // Estatísticas da pesquisa
+	IdVertice* pilha; // Identificadores dos vértices do caminho atual
+	int profundidade; // Número de vértices do caminho atual
+	double inicio; // Instante de início da pesquisa em milissegundos
+	bool interrompida; // Indica se algum limite foi atingido
+} PesquisaLimitada;
+
+/**
+ * Função para verificar se a pesquisa limitada deve parar.
+ *
+ * O relógio só é consultado de 64 em 64 vértices expandidos, para que o custo da
+ * verificação não pese nos grafos pequenos nem nos percursos longos.
+ *
+ * @param p O apontador para o estado da pesquisa.
+ * @return Retorna true se um dos limites foi atingido, caso contrário, retorna false.
+ */
+static bool LimiteAtingido(PesquisaLimitada* p) {
+	LimitesPesquisa* limites = p->limites;
+	long nos = p->estat->nosExpandidos;
+	if (limites->maxNos > 0 && nos >= limites->maxNos) {
+		p->interrompida = true;
+	}
+	else if (limites->tempoMaximo > 0 && (nos & 63) == 0 && TempoAtualMs() - p->inicio >= limites->tempoMaximo) {
+		p->interrompida = true;
+	}
+	return p->interrompida;
+}
+
+/**
+ * Função para buscar o caminho máximo a partir de um vértice dado, respeitando os limites da pesquisa.
+ *
+ * Esta função segue a mesma busca em profundidade que BuscarCaminhoMaximo, mas guarda o caminho atual numa
+ * pilha para poder copiar o melhor caminho para o resultado, conta os vértices expandidos, chama a função de
+ * progresso e pára quando um dos limites é atingido. Ao parar, cada vértice do caminho aberto soma à fronteira
+ * os adjacentes que ficaram por explorar.
+ *
+ * @param v O vértice a expandir.
+ * @param somaAtual A soma acumulada dos valores dos vértices ao longo do caminho atual.
+ * @param p O apontador para o estado da pesquisa.
+ */
+static void BuscarCaminhoMaximoLimitado(Vertice* v, TipoSoma somaAtual, PesquisaLimitada* p) {
+	EstatisticasPesquisa* estat = p->estat;
+	if (LimiteAtingido(p)) {
+		if (p->profundidade > 0) estat->fronteiraPendente++; // O próprio vértice fica por explorar
+		else estat->origensPendentes++;
+		return;
+	}
+	Resultado* res = p->res;
+	estat->nosExpandidos++;
+	v->visitado = true;
+	somaAtual += v->valor;
+	p->pilha[p->profundidade++] = v->id;
+	if (p->profundidade > estat->profundidadeMaxima) {
+		estat->profundidadeMaxima = p->profundidade;
+	}
+	// Copiar o caminho atual para o resultado se a soma atual for maior (como em AtualizarResultado)
+	if (somaAtual > res->soma) {
+		res->soma = somaAtual;
+		res->caminho = v;
+		res->tamanho = p->profundidade;
+		memcpy(res->percurso, p->pilha, p->profundidade * sizeof(IdVertice));
+	}
+	if (p->limites->progresso != NULL && p->limites->intervaloProgresso > 0 && estat->nosExpandidos % p->limites->intervaloProgresso == 0) {
+		p->limites->progresso(res->soma, estat->nosExpandidos, p->limites->contexto);
+	}
+	for (int i = 0; i < v->numAdjacentes; i++) {
+		Vertice* verticeAdjacente = OndeEstaVerticeGrafo(res->grafo, v->adjacentes[i]);
+		if (verticeAdjacente != NULL && !verticeAdjacente->visitado) {
+			if (p->interrompida) {
+				estat->fronteiraPendente++; // Adjacente que ficou por explorar
+			}
+			else {
+				BuscarCaminhoMaximoLimitado(verticeAdjacente, somaAtual, p);
+			}
+		}
+	}
+	p->profundidade--;
+	v->visitado = false;
+}
+
+/**
+ * Função para encontrar o caminho com a soma máxima de valores num grafo dentro de um orçamento de tempo ou de vértices.
+ *
+ * Esta função faz a mesma pesquisa que CaminhoSomaMaxima, mas pode ser interrompida ao fim de um tempo máximo ou
+ * de um número máximo de vértices expandidos. Em qualquer dos casos devolve o melhor caminho encontrado até ao
+ * momento, com o percurso completo, e indica se o resultado é exato (a pesquisa terminou) ou parcial.
+ * Se for indicada uma função de progresso, esta é chamada periodicamente com a melhor soma encontrada.
+ *
+ * @param g O apontador para o grafo onde o caminho com a soma máxima será procurado.
+ * @param limites O apontador para os limites da pesquisa (NULL para uma pesquisa sem limites).
+ * @param estat O apontador para as estatísticas da pesquisa a preencher (pode ser NULL).
+ * @return Retorna um apontador para o resultado com o melhor caminho encontrado, a destruir com DestruirResultado.
+ *         Como em CaminhoSomaMaxima, só são aceites somas positivas: se nenhum caminho tiver soma maior que 0, o
+ *         resultado fica com soma 0, sem caminho e com tamanho 0.
+ *         Retorna NULL se o grafo for nulo ou se não for possível alocar memória para o resultado.
+ */
+Resultado* CaminhoSomaMaximaLimitado(Grafo* g, LimitesPesquisa* limites, EstatisticasPesquisa* estat) {
+	if (g == NULL) return NULL;
+	LimitesPesquisa semLimites = { 0 };
+	EstatisticasPesquisa estatLocal;
+	if (limites == NULL) limites = &semLimites;
+	if (estat == NULL) estat = &estatLocal;
+	memset(estat, 0, sizeof(EstatisticasPesquisa));
+	Resultado* res = (Resultado*)malloc(sizeof(Resultado));
+	if (res == NULL) return NULL;
+	int tamanhoMaximo = g->numVertices > 0 ? g->numVertices : 1;
+	res->soma = 0;
+	res->caminho = NULL;
+	res->grafo = g;
+	res->tamanho = 0;
+	res->exato = false;
+	res->percurso = (IdVertice*)malloc(tamanhoMaximo * sizeof(IdVertice));
+	IdVertice* pilha = (IdVertice*)malloc(tamanhoMaximo * sizeof(IdVertice));
+	if (res->percurso == NULL || pilha == NULL) {
+		free(pilha);
+		DestruirResultado(res);
+		return NULL;
+	}
+	PesquisaLimitada p = { res, limites, estat, pilha, 0, TempoAtualMs(), false };
+	Vertice* v = g->inicioGrafo; // Iniciar a busca a partir do primeiro vértice do grafo
+	while (v != NULL) {
+		if (p.interrompida) {
+			estat->origensPendentes++; // Vértice de partida que ficou por explorar
+		}
+		else {
+			BuscarCaminhoMaximoLimitado(v, 0, &p);
+		}
+		v = v->proxVertice;
+	}
+	free(pilha);
+	res->exato = !p.interrompida;
+	estat->exato = res->exato;
+	estat->tempoDecorrido = TempoAtualMs() - p.inicio;
+	if (limites->progresso != NULL) {
+		limites->progresso(res->soma, estat->nosExpandidos, limites->contexto); // Última chamada com o resultado final
+	}
+	return res;
+}
+
+#pragma endregion
+
+#pragma region CaminhoSomaMaximaEntre
+
+/**
+ * Função para marcar os vértices a partir dos quais se pode chegar ao destino (procura em largura pelas arestas de entrada).
+ *
+ * @param gc O apontador para o grafo compacto.
+ * @param destino O índice do vértice de destino.
+ * @param alcanca O vetor a preencher (true se o vértice alcança o destino).
+ * @param fila Vetor auxiliar com espaço para todos os vértices.
+ */
+static void MarcarQueAlcancam(GrafoCompacto* gc, int destino, bool* alcanca, int* fila) {
+	int cabeca = 0, fim = 0;
+	alcanca[destino] = true;
+	fila[fim++] = destino;
+	while (cabeca < fim) {
+		int v = fila[cabeca++];
+		for (int k = gc->inicioAnt[v]; k < gc->inicioAnt[v + 1]; k++) {
+			int u = gc->origens[k];
+			if (!alcanca[u]) {
+				alcanca[u] = true;
+				fila[fim++] = u;
+			}
+		}
+	}
+}
+
+/**
+ * Função para procurar, por programação dinâmica pela ordem topológica, o caminho de soma máxima entre dois vértices,
+ * quando os vértices relevantes (os que alcançam o destino) não fazem parte de nenhum ciclo.
+ *
+ * @return Retorna true se o destino foi alcançado.
+ */
+static bool SomaMaximaEntreAciclico(GrafoCompacto* gc, int* componente, int origem, int destino, bool* alcanca,
+	TipoSoma* soma, int* anterior, int* ordem) {
+	int n = gc->numVertices;
+	for (int v = 0; v < n; v++) {
+		ordem[componente[v]] = v; // Cada vértice relevante é uma componente; os restantes não são usados
+		soma[v] = SOMA_MIN;
+		anterior[v] = -1;
+	}
+	soma[origem] = gc->valores[origem];
+	for (int c = componente[origem]; c <= componente[destino]; c++) {
+		int v = ordem[c];
+		if (!alcanca[v] || soma[v] == SOMA_MIN) continue;
+		if (v == destino) break;
+		for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+			int w = gc->destinos[k];
+			if (alcanca[w] && soma[v] + gc->valores[w] > soma[w]) {
+				soma[w] = soma[v] + gc->valores[w];
+				anterior[w] = v;
+			}
+		}
+	}
+	return soma[destino] != SOMA_MIN;
+}
+
+/**
+ * Função para procurar, com uma pesquisa em profundidade (pilha explícita), o caminho simples de soma máxima entre dois
+ * vértices. Nunca entra em vértices que não alcançam o destino, e abandona um caminho quando nem somando todos os valores
+ * positivos ainda livres conseguiria ultrapassar a melhor soma encontrada.
+ *
+ * O vetor "noCaminho" tem de estar a false em todos os vértices (e volta a ficar assim no fim).
+ *
+ * @return Retorna true se o destino foi alcançado; o melhor caminho fica em "melhor" (índices) e "tamanhoMelhor".
+ */
+static bool SomaMaximaEntrePesquisa(GrafoCompacto* gc, int origem, int destino, bool* alcanca, bool* noCaminho, int* pilha,
+	int* proximaAresta, TipoSoma* somas, int* melhor, int* tamanhoMelhor, TipoSoma* melhorSoma) {
+	int n = gc->numVertices;
+	TipoSoma positivosLivres = 0; // Soma dos valores positivos dos vértices relevantes fora do caminho
+	for (int v = 0; v < n; v++) {
+		if (alcanca[v] && gc->valores[v] > 0) positivosLivres += gc->valores[v];
+	}
+	bool encontrou = false;
+	int profundidade = 0;
+	// Entrar na origem
+	pilha[profundidade] = origem;
+	proximaAresta[profundidade] = gc->inicioAdj[origem];
+	somas[profundidade] = gc->valores[origem];
+	profundidade++;
+	noCaminho[origem] = true;
+	if (gc->valores[origem] > 0) positivosLivres -= gc->valores[origem];
+	while (profundidade > 0) {
+		int d = profundidade - 1;
+		int v = pilha[d];
+		bool recuar = v == destino; // Um caminho simples não pode voltar a passar pelo destino
+		if (v == destino && (!encontrou || somas[d] > *melhorSoma)) {
+			encontrou = true;
+			*melhorSoma = somas[d];
+			*tamanhoMelhor = profundidade;
+			memcpy(melhor, pilha, profundidade * sizeof(int));
+		}
+		if (encontrou && somas[d] + positivosLivres <= *melhorSoma) recuar = true; // Poda pelo limite superior
+		int k = proximaAresta[d];
+		if (!recuar) {
+			while (k < gc->inicioAdj[v + 1] && (noCaminho[gc->destinos[k]] || !alcanca[gc->destinos[k]])) k++;
+		}
+		if (recuar || k >= gc->inicioAdj[v + 1]) {
+			noCaminho[v] = false;
+			if (gc->valores[v] > 0) positivosLivres += gc->valores[v];
+			profundidade--;
+			continue;
+		}
+		proximaAresta[d] = k + 1;
+		int w = gc->destinos[k];
+		pilha[profundidade] = w;
+		proximaAresta[profundidade] = gc->inicioAdj[w];
+		somas[profundidade] = somas[d] + gc->valores[w];
+		profundidade++;
+		noCaminho[w] = true;
+		if (gc->valores[w] > 0) positivosLivres -= gc->valores[w];
+	}
+	return encontrou;
+}
+
+/**
+ * Função para encontrar o caminho simples com a soma máxima de valores entre dois vértices de um grafo compacto.
+ *
+ * Primeiro são marcados os vértices que alcançam o destino (procura em largura pelas arestas de entrada): os outros
+ * nunca são expandidos. Se nenhum vértice marcado fizer parte de um ciclo, o caminho é calculado por programação
+ * dinâmica pela ordem topológica, em tempo linear; caso contrário é feita uma pesquisa em profundidade com poda.
+ * O grafo compacto só é lido, pelo que pode ser uma versão publicada de um grafo versionado.
+ *
+ * @param gc O apontador para o grafo compacto.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Caminho encontrado.
+ *        -  0: Não há caminho entre os dois vértices.
+ *        - -1: Um ou ambos os vértices não existem no grafo.
+ *        - -3: Falta de memória.
+ * @return Retorna um apontador para o resultado com o caminho e a sua soma, a destruir com DestruirResultado,
+ *         ou NULL se não houver caminho.
+ */
+Resultado* CaminhoSomaMaximaEntreCompacto(GrafoCompacto* gc, IdVertice idOrigem, IdVertice idDestino, int* res) {
+	*res = -1;
+	int origem = IndiceGrafoCompacto(gc, idOrigem);
+	int destino = IndiceGrafoCompacto(gc, idDestino);
+	if (origem < 0 || destino < 0) return NULL;
+	*res = -3;
+	int n = gc->numVertices;
+	bool* alcanca = (bool*)calloc(n + 1, sizeof(bool));
+	bool* noCaminho = (bool*)calloc(n + 1, sizeof(bool)); // Vértices do caminho atual (pesquisa em profundidade)
+	int* auxiliar = (int*)malloc((n + 1) * sizeof(int));
+	int* caminho = (int*)malloc((n + 1) * sizeof(int));
+	int* anterior = (int*)malloc((n + 1) * sizeof(int));
+	TipoSoma* somas = (TipoSoma*)malloc((n + 1) * sizeof(TipoSoma));
+	int numComponentes = 0;
+	int* componente = ComponentesFortementeLigadas(gc, &numComponentes);
+	Resultado* resultado = NULL;
+	if (alcanca != NULL && noCaminho != NULL && auxiliar != NULL && caminho != NULL && anterior != NULL && somas != NULL && componente != NULL) {
+		MarcarQueAlcancam(gc, destino, alcanca, auxiliar);
+		// Os vértices relevantes são acíclicos se nenhum partilhar a componente com outro nem tiver um lacete
+		int* tamanhoComp = auxiliar;
+		memset(tamanhoComp, 0, (n + 1) * sizeof(int));
+		for (int v = 0; v < n; v++) tamanhoComp[componente[v]]++;
+		bool aciclico = true;
+		for (int v = 0; v < n && aciclico; v++) {
+			if (!alcanca[v]) continue;
+			if (tamanhoComp[componente[v]] > 1) aciclico = false;
+			for (int k = gc->inicioAdj[v]; k < gc->inicioAdj[v + 1]; k++) {
+				if (gc->destinos[k] == v) aciclico = false;
+			}
+		}
+		bool encontrou = false;
+		TipoSoma soma = 0;
+		int tamanho = 0;
+		*res = 0;
+		if (!alcanca[origem]) {
+			// A origem não alcança o destino: não há caminho
+		}
+		else if (aciclico) {
+			encontrou = SomaMaximaEntreAciclico(gc, componente, origem, destino, alcanca, somas, anterior, auxiliar);
+			if (encontrou) {
+				soma = somas[destino];
+				for (int v = destino; v >= 0; v = anterior[v]) tamanho++;
+				int i = tamanho;
+				for (int v = destino; v >= 0; v = anterior[v]) caminho[--i] = v;
+			}
+		}
+		else {
+			encontrou = SomaMaximaEntrePesquisa(gc, origem, destino, alcanca, noCaminho, auxiliar, anterior, somas, caminho, &tamanho, &soma);
+		}
+		if (encontrou) {
+			*res = -3;
+			resultado = (Resultado*)malloc(sizeof(Resultado));
+			IdVertice* percurso = (IdVertice*)malloc(tamanho * sizeof(IdVertice));
+			if (resultado != NULL && percurso != NULL) {
+				for (int i = 0; i < tamanho; i++) percurso[i] = gc->ids[caminho[i]];
+				resultado->soma = soma;
+				resultado->caminho = gc->vertices != NULL ? gc->vertices[destino] : NULL;
+				resultado->grafo = gc->grafo;
+				resultado->percurso = percurso;
+				resultado->tamanho = tamanho;
+				resultado->exato = true;
+				*res = 1;
+			}
+			else {
+				free(resultado);
+				free(percurso);
+				resultado = NULL;
+			}
+		}
+	}
+	free(alcanca);
+	free(noCaminho);
+	free(auxiliar);
+	free(caminho);
+	free(anterior);
+	free(somas);
+	free(componente);
+	return resultado;
+}
+
+/**
+ * Função para encontrar o caminho simples com a soma máxima de valores entre dois vértices.
+ *
+ * O caminho é calculado sobre uma cópia compacta do grafo (ver CaminhoSomaMaximaEntreCompacto).
+ *
+ * @param g O apontador para o grafo.
+ * @param idOrigem O identificador do vértice de origem.
+ * @param idDestino O identificador do vértice de destino.
+ * @param res Apontador para uma variável inteira que será atualizada com o resultado da operação:
+ *        -  1: Caminho encontrado.
+ *        -  0: Não há caminho entre os dois vértices.
+ *        - -1: Um ou ambos os vértices não existem no grafo.
+ *        - -3: Falta de memória.
+ * @return Retorna um apontador para o resultado com o caminho e a sua soma, a destruir com DestruirResultado,
+ *         ou NULL se não houver caminho.
+ */
+Resultado* CaminhoSomaMaximaEntre(Grafo* g, IdVertice idOrigem, IdVertice idDestino, int* res) {
+	*res = -1;
+	if (!ExisteVerticeGrafo(g, idOrigem) || !ExisteVerticeGrafo(g, idDestino)) return NULL;
+	*res = -3;
+	GrafoCompacto* gc = CriarGrafoCompacto(g);
+	if (gc == NULL) return NULL;
+	Resultado* resultado = CaminhoSomaMaximaEntreCompacto(gc, idOrigem, idDestino, res);
+	DestruirGrafoCompacto(gc);
+	return resultado;
+}
+
+#pragma endregion
+
 #pragma endregion
\ No newline at end of file
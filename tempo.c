@@ -0,0 +1,33 @@
+/*********************************************************************
+ * @file   tempo.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#pragma region TEMPO
+
+#pragma region TempoAtualMs
+
+ /**
+  * @brief Obtém o instante atual em milissegundos.
+  *
+  * Esta função utiliza um relógio de parede (e não o tempo de processador), de forma
+  * a que os limites de tempo das pesquisas correspondam ao tempo de resposta real.
+  *
+  * @return O instante atual em milissegundos, com resolução inferior ao milissegundo.
+  */
+double TempoAtualMs() {
+	struct timespec ts;
+	if (timespec_get(&ts, TIME_UTC) == 0) {
+		return (double)clock() * 1000.0 / CLOCKS_PER_SEC; // Recorre ao relógio do processador se o relógio de parede falhar
+	}
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,255 @@
+/*********************************************************************
+ * @file   versoes.c
+ * @brief
+ *
+ * @author Yuri Nascimento
+ * @email  a27957@alunos.ipca.pt
+ * @date   May 2024
+ *********************************************************************/
+#include "header.h"
+
+#define EPOCA_LIVRE LLONG_MAX // Época de um leitor que não está a ler nenhuma versão
+#define PASSO_LEITOR 8 // Distância (em posições) entre as épocas de dois leitores, para ficarem em linhas de cache diferentes
+
+// Operações atómicas (com ordem sequencial) sobre a versão atual e as épocas
+#ifdef _MSC_VER
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define EscreverVersao(p, v) ((void)InterlockedExchangePointer((PVOID volatile*)(p), (v)))
+#define LerVersao(p) ((VersaoGrafo*)InterlockedCompareExchangePointer((PVOID volatile*)(p), NULL, NULL))
+#define LerEpoca(p) InterlockedCompareExchange64((p), 0, 0)
+#define EscreverEpoca(p, e) InterlockedExchange64((p), (e))
+#define AvancarEpoca(p) InterlockedIncrement64(p)
+#else
+#define EscreverVersao(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define LerVersao(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define LerEpoca(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define EscreverEpoca(p, e) __atomic_store_n((p), (e), __ATOMIC_SEQ_CST)
+#define AvancarEpoca(p) __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#endif
+
+#pragma region VERSOES
+
+#pragma region Auxiliares
+
+/**
+ * Cria a próxima versão do grafo. Se só os valores mudaram, a nova versão partilha com a anterior as arestas e os
+ * identificadores (que passam a ser libertados com a nova versão) e só os valores são copiados; caso contrário é
+ * criada uma cópia compacta completa, com a sua própria tabela de identificadores.
+ */
+static VersaoGrafo* CriarVersao(Grafo* g, VersaoGrafo* anterior, bool soValores) {
+	VersaoGrafo* v = (VersaoGrafo*)calloc(1, sizeof(VersaoGrafo));
+	if (v == NULL) return NULL;
+	int n = g->numVertices;
+	if (soValores && anterior != NULL && anterior->gc->numVertices == n) {
+		v->gc = (GrafoCompacto*)malloc(sizeof(GrafoCompacto));
+		TipoValor* valores = (TipoValor*)malloc((n + 1) * sizeof(TipoValor));
+		if (v->gc == NULL || valores == NULL) {
+			free(v->gc);
+			free(valores);
+			free(v);
+			return NULL;
+		}
+		*v->gc = *anterior->gc;
+		for (int i = 0; i < n; i++) valores[i] = g->porIndice[i]->valor;
+		v->gc->valores = valores;
+		VerificarPesosNegativosCompacto(v->gc); // Os pesos mudam com os valores
+		v->donoEstrutura = true;
+		anterior->donoEstrutura = false;
+		return v;
+	}
+	v->gc = CriarGrafoCompacto(g);
+	TabelaIds* tabela = (TabelaIds*)malloc(sizeof(TabelaIds));
+	bool ok = v->gc != NULL && tabela != NULL && CriarTabelaIds(tabela, n > 0 ? n : 1);
+	if (v->gc != NULL && tabela != NULL && ok) v->gc->tabelaIds = tabela;
+	else free(tabela);
+	for (int i = 0; i < n && ok; i++) ok = InserirTabelaIds(tabela, v->gc->ids[i], i);
+	if (!ok) {
+		DestruirGrafoCompacto(v->gc);
+		free(v);
+		return NULL;
+	}
+	// A versão não pode apontar para o grafo, que vai mudando
+	free(v->gc->vertices);
+	v->gc->vertices = NULL;
+	v->gc->grafo = NULL;
+	v->donoEstrutura = true;
+	return v;
+}
+
+/**
+ * Liberta uma versão (as arestas e os identificadores só se ainda lhe pertencerem).
+ */
+static void DestruirVersao(VersaoGrafo* v) {
+	if (v->donoEstrutura) DestruirGrafoCompacto(v->gc);
+	else {
+		free(v->gc->valores);
+		free(v->gc);
+	}
+	free(v);
+}
+
+#pragma endregion
+
+#pragma region CriarGrafoVersionado
+
+/**
+ * @brief Cria um grafo versionado, em que um escritor altera o grafo enquanto vários leitores fazem pesquisas.
+ *
+ * Os leitores nunca leem o grafo mutável: leem versões imutáveis (cópias compactas) publicadas pelo escritor com
+ * PublicarVersao. Cada leitor fixa a época atual antes de obter a versão (FixarVersao) e liberta-a no fim
+ * (LibertarVersao), sem trincos. Uma versão substituída só é libertada quando todos os leitores que a podiam estar a
+ * ler a tiverem libertado (recuperação por épocas). A primeira versão é publicada aqui.
+ *
+ * @param g O apontador para o grafo (passa a ser alterado só pelo escritor; não é destruído com o grafo versionado).
+ * @param numLeitores O número de leitores (cada um identificado por um número de 0 a numLeitores - 1).
+ * @return Apontador para o grafo versionado, ou NULL se os argumentos forem inválidos ou se a alocação de memória falhar.
+ */
+GrafoVersionado* CriarGrafoVersionado(Grafo* g, int numLeitores) {
+	if (g == NULL || numLeitores <= 0) return NULL;
+	GrafoVersionado* gv = (GrafoVersionado*)calloc(1, sizeof(GrafoVersionado));
+	if (gv == NULL) return NULL;
+	gv->grafo = g;
+	gv->numLeitores = numLeitores;
+	gv->leitores = (volatile long long*)malloc((size_t)numLeitores * PASSO_LEITOR * sizeof(long long));
+	VersaoGrafo* primeira = CriarVersao(g, NULL, false);
+	if (gv->leitores == NULL || primeira == NULL) {
+		if (primeira != NULL) DestruirVersao(primeira);
+		free((void*)gv->leitores);
+		free(gv);
+		return NULL;
+	}
+	for (int i = 0; i < numLeitores; i++) gv->leitores[i * PASSO_LEITOR] = EPOCA_LIVRE;
+	primeira->numero = gv->numVersoes = 1;
+	gv->epoca = 1;
+	EscreverVersao(&gv->atual, primeira);
+	return gv;
+}
+
+#pragma endregion
+
+#pragma region PublicarVersao
+
+/**
+ * @brief Publica uma nova versão do grafo, com as alterações feitas pelo escritor desde a última publicação.
+ *
+ * A nova versão passa a ser a devolvida por FixarVersao; os leitores que já tinham uma versão continuam a lê-la
+ * sem alterações. A versão anterior fica retirada até poder ser libertada (ver RecolherVersoes, chamada aqui).
+ * Só pode ser chamada pelo escritor.
+ *
+ * @param gv O apontador para o grafo versionado.
+ * @param soValores `true` se desde a última publicação só mudaram valores de vértices (sem inserir ou eliminar
+ *        vértices ou arestas): a nova versão partilha as arestas com a anterior e só os valores são copiados.
+ * @return `true` se a versão foi publicada, `false` se o grafo versionado for nulo ou se a alocação de memória falhar.
+ */
+bool PublicarVersao(GrafoVersionado* gv, bool soValores) {
+	if (gv == NULL) return false;
+	VersaoGrafo* anterior = gv->atual; // Só o escritor altera a versão atual
+	VersaoGrafo* nova = CriarVersao(gv->grafo, anterior, soValores);
+	if (nova == NULL) return false;
+	nova->numero = ++gv->numVersoes;
+	EscreverVersao(&gv->atual, nova);
+	// Os leitores que fixarem a nova época já obtêm a nova versão
+	anterior->retiradaEm = AvancarEpoca(&gv->epoca);
+	anterior->proxRetirada = gv->retiradas;
+	gv->retiradas = anterior;
+	RecolherVersoes(gv);
+	return true;
+}
+
+#pragma endregion
+
+#pragma region FixarVersao
+
+/**
+ * @brief Obtém a versão atual do grafo para um leitor, impedindo que seja libertada enquanto ele a ler.
+ *
+ * A versão devolvida é imutável e pode ser lida sem trincos (por exemplo, com CaminhoSomaMaximaEntreCompacto,
+ * NiveisLargura ou CriarPesquisaBidirecional sobre `versao->gc`) até o leitor chamar LibertarVersao.
+ * Cada leitor só pode ter uma versão fixada de cada vez.
+ *
+ * @param gv O apontador para o grafo versionado.
+ * @param leitor O número do leitor (de 0 a numLeitores - 1).
+ * @return Apontador para a versão, ou NULL se os argumentos forem inválidos.
+ */
+VersaoGrafo* FixarVersao(GrafoVersionado* gv, int leitor) {
+	if (gv == NULL || leitor < 0 || leitor >= gv->numLeitores) return NULL;
+	EscreverEpoca(&gv->leitores[leitor * PASSO_LEITOR], LerEpoca(&gv->epoca));
+	return LerVersao(&gv->atual);
+}
+
+#pragma endregion
+
+#pragma region LibertarVersao
+
+/**
+ * @brief Indica que um leitor terminou de ler a versão que fixou.
+ *
+ * @param gv O apontador para o grafo versionado.
+ * @param leitor O número do leitor (de 0 a numLeitores - 1).
+ */
+void LibertarVersao(GrafoVersionado* gv, int leitor) {
+	if (gv == NULL || leitor < 0 || leitor >= gv->numLeitores) return;
+	EscreverEpoca(&gv->leitores[leitor * PASSO_LEITOR], EPOCA_LIVRE);
+}
+
+#pragma endregion
+
+#pragma region RecolherVersoes
+
+/**
+ * @brief Liberta as versões retiradas que já não podem estar a ser lidas.
+ *
+ * Uma versão retirada na época `e` só pode estar a ser lida por leitores que fixaram uma época anterior a `e`,
+ * pelo que é libertada quando nenhum leitor tiver uma época fixada menor do que `e`. Só pode ser chamada pelo escritor.
+ *
+ * @param gv O apontador para o grafo versionado.
+ * @return O número de versões libertadas.
+ */
+int RecolherVersoes(GrafoVersionado* gv) {
+	if (gv == NULL) return 0;
+	long long minima = EPOCA_LIVRE;
+	for (int i = 0; i < gv->numLeitores; i++) {
+		long long e = LerEpoca(&gv->leitores[i * PASSO_LEITOR]);
+		if (e < minima) minima = e;
+	}
+	int libertadas = 0;
+	VersaoGrafo** anterior = &gv->retiradas;
+	while (*anterior != NULL) {
+		VersaoGrafo* v = *anterior;
+		if (v->retiradaEm <= minima) {
+			*anterior = v->proxRetirada;
+			DestruirVersao(v);
+			libertadas++;
+		}
+		else anterior = &v->proxRetirada;
+	}
+	return libertadas;
+}
+
+#pragma endregion
+
+#pragma region DestruirGrafoVersionado
+
+/**
+ * @brief Liberta todas as versões de um grafo versionado (nenhum leitor pode estar a ler).
+ *
+ * O grafo mutável não é destruído.
+ *
+ * @param gv O apontador para o grafo versionado.
+ */
+void DestruirGrafoVersionado(GrafoVersionado* gv) {
+	if (gv == NULL) return;
+	while (gv->retiradas != NULL) {
+		VersaoGrafo* v = gv->retiradas;
+		gv->retiradas = v->proxRetirada;
+		DestruirVersao(v);
+	}
+	if (gv->atual != NULL) DestruirVersao(gv->atual);
+	free((void*)gv->leitores);
+	free(gv);
+}
+
+#pragma endregion
+
+#pragma endregion
\ No newline at end of file
@@ -13,14 +13,18 @@
 #pragma region DestruirVertice
 
  /**
-  * @brief Destri um vrtice, libertando a memria associada ao mesmo.
+  * @brief Destrói um vértice, libertando a memória associada ao mesmo.
   *
-  * Esta funo recebe um apontador para um vrtice e liberta a memria
-  * associada ao mesmo utilizando a funo `free`.
+  * Esta função recebe um apontador para um vértice e liberta a memória
+  * associada ao mesmo e ao seu vetor de adjacências utilizando a função `free`. Os vértices que fazem parte
+  * de um bloco contíguo (ver ReordenarGrafo) não são libertados individualmente.
   *
-  * @param v Apontador para o vrtice a ser destrudo.
+  * @param v Apontador para o vértice a ser destruído.
   */
 void DestruirVertice(Vertice* v) {
+	if (v == NULL) return;
+	DestruirAdjacentes(v);
+	if (v->emBloco) return; // Os vértices de um bloco contíguo são libertados com o bloco
 	free(v);
 }
 
@@ -29,24 +33,30 @@ void DestruirVertice(Vertice* v) {
 #pragma region CriarVertice
 
 /**
- * @brief Cria um novo vrtice com um identificador especificado.
+ * @brief Cria um novo vértice com um identificador especificado.
  *
- * Esta funo aloca memria para um novo vrtice e inicializa seus campos.
- * Se a alocao de memria falhar, a funo retorna `NULL`.
+ * Esta função aloca memória para um novo vértice e inicializa seus campos.
+ * Se a alocação de memória falhar, a função retorna `NULL`.
  *
- * @param id O identificador do vrtice a ser criado.
- * @param valor O valor do vrtice a ser criado.
- * @return Apontador para o novo vrtice criado, ou `NULL` se a alocao de memria falhar.
+ * @param id O identificador do vértice a ser criado.
+ * @param valor O valor do vértice a ser criado.
+ * @return Apontador para o novo vértice criado, ou `NULL` se a alocação de memória falhar.
  */
-Vertice* CriarVertice(int id, int valor) {
-	Vertice* v = (Vertice*)malloc(sizeof(Vertice)); // Aloca memria para criar o vrtice
+Vertice* CriarVertice(IdVertice id, TipoValor valor) {
+	Vertice* v = (Vertice*)malloc(sizeof(Vertice)); // Aloca memória para criar o vértice
 	if (v == NULL) return NULL;
-	// Inicializa o novo vrtice
+	// Inicializa o novo vértice
 	v->id = id;
+	v->indice = -1; // O índice denso só é atribuído quando o vértice é inserido num grafo
 	v->valor = valor;
 	v->visitado = false;
-	v->proxAdjacente = NULL;
+	v->emBloco = false;
+	v->adjacentes = NULL; // O vetor de adjacências só é alocado na primeira inserção
+	v->numAdjacentes = 0;
+	v->capAdjacentes = 0;
+	v->adjEmBloco = false;
 	v->proxVertice = NULL;
+	v->antVertice = NULL;
 	return v;
 }
 
@@ -55,48 +65,48 @@ Vertice* CriarVertice(int id, int valor) {
 #pragma region InserirVertice
 
 /**
- * @brief Insere um novo vrtice na lista de vrtices do grafo.
+ * @brief Insere um novo vértice na lista de vértices do grafo.
  *
- * Esta funo insere um novo vrtice na lista de vrtices do grafo,
- * mantendo a ordem crescente dos identificadores dos vrtices. Se a lista
- * estiver vazia, o novo vrtice  inserido como o primeiro vrtice. A funo
- * tambm atualiza um indicador de sucesso.
+ * Esta função insere um novo vértice na lista de vértices do grafo,
+ * mantendo a ordem crescente dos identificadores dos vértices. Se a lista
+ * estiver vazia, o novo vértice é inserido como o primeiro vértice. A função
+ * também atualiza um indicador de sucesso.
  *
- * @param vertices Apontador para o incio da lista de vrtices.
- * @param novoVertice Apontador para o novo vrtice a ser inserido.
- * @param res Apontador para uma varivel booleana que indica o sucesso da insero.
- *            Ser definido como `true` se a insero for bem-sucedida, caso contrrio `false`.
- * @return Apontador para o incio atualizada da lista de vrtices.
+ * @param vertices Apontador para o início da lista de vértices.
+ * @param novoVertice Apontador para o novo vértice a ser inserido.
+ * @param res Apontador para uma variável booleana que indica o sucesso da inserção.
+ *            Será definido como `true` se a inserção for bem-sucedida, caso contrário `false`.
+ * @return Apontador para o início atualizada da lista de vértices.
  */
 Vertice* InserirVertice(Vertice* vertices, Vertice* novoVertice, bool* res) {
 	*res = false;
-	// Insere um novo vrtice no grafo vazio
+	// Insere um novo vértice no grafo vazio
 	if (vertices == NULL) {
 		*res = 1;
+		novoVertice->antVertice = NULL;
 		vertices = novoVertice;
 		return vertices;
 	}
-	// Verifica se o vrtice j existe na lista de vrtices
-	if (ExisteVertice(vertices, novoVertice->id)) {
-		return vertices;
-	}
 	else
 	{
-		// Procura onde inserir o vrtice
+		// Procura onde inserir o vértice (a lista está ordenada, pelo que um vértice repetido só pode estar nessa posição)
 		Vertice* anterior = NULL;
 		Vertice* aux = vertices;
 		while (aux != NULL && aux->id < novoVertice->id) {
-			anterior = aux; // O vrtice "anterior" passa a apontar para o vrtice que "aux" estava a apontar
-			aux = aux->proxVertice; // O vrtice "aux" passa a apontar para o prximo vrtice
+			anterior = aux; // O vértice "anterior" passa a apontar para o vértice que "aux" estava a apontar
+			aux = aux->proxVertice; // O vértice "aux" passa a apontar para o próximo vértice
 		}
+		if (aux != NULL && aux->id == novoVertice->id) return vertices; // O vértice já existe na lista de vértices
 		*res = true;
+		novoVertice->antVertice = anterior;
+		if (aux != NULL) aux->antVertice = novoVertice;
 		if (anterior == NULL) {
-			novoVertice->proxVertice = vertices; // "novoVertice" e inserido no incio da lista e aponta para o vrtice inicial(vrtices)
-			vertices = novoVertice; // "vertices" passa para o incio da lista e aponta para "novoVertice"(vrtice que foi inserido anteriormente)
+			novoVertice->proxVertice = vertices; // "novoVertice" e inserido no início da lista e aponta para o vértice inicial(vértices)
+			vertices = novoVertice; // "vertices" passa para o início da lista e aponta para "novoVertice"(vértice que foi inserido anteriormente)
 		}
 		else {
-			novoVertice->proxVertice = aux; // "novoVertice" e inserido antes do vrtice que estava a ser apontado por "aux"(ultimo vrtice da lista)
-			anterior->proxVertice = novoVertice; // O vrtice anterior fica a apontar para "novoVertice"(vrtice que foi inserido anteriormente)
+			novoVertice->proxVertice = aux; // "novoVertice" e inserido antes do vértice que estava a ser apontado por "aux"(ultimo vértice da lista)
+			anterior->proxVertice = novoVertice; // O vértice anterior fica a apontar para "novoVertice"(vértice que foi inserido anteriormente)
 		}
 	}
 	return vertices;
@@ -107,21 +117,21 @@ Vertice* InserirVertice(Vertice* vertices, Vertice* novoVertice, bool* res) {
 #pragma region ExisteVertice
 
 /**
- * @brief Verifica se um vrtice com um determinado identificador existe na lista de vrtices.
+ * @brief Verifica se um vértice com um determinado identificador existe na lista de vértices.
  *
- * Esta funo percorre a lista de vrtices a partir do vrtice inicial e verifica
- * se existe um vrtice com o identificador especificado.
+ * Esta função percorre a lista de vértices a partir do vértice inicial e verifica
+ * se existe um vértice com o identificador especificado.
  *
- * @param inicio Apontador para o vrtice inicial da lista.
- * @param idVertice O identificador do vrtice a ser procurado.
- * @return `true` se o vrtice com o identificador especificado existir na lista, caso contrrio `false`.
+ * @param inicio Apontador para o vértice inicial da lista.
+ * @param idVertice O identificador do vértice a ser procurado.
+ * @return `true` se o vértice com o identificador especificado existir na lista, caso contrário `false`.
  */
-bool ExisteVertice(Vertice* inicio, int idVertice) {
+bool ExisteVertice(Vertice* inicio, IdVertice idVertice) {
 	if (inicio == NULL) return false;
-	Vertice* aux = inicio; // "aux" fica a apontar para o vrtice inicial
+	Vertice* aux = inicio; // "aux" fica a apontar para o vértice inicial
 	while (aux) {
-		if (aux->id == idVertice) return true; // Retorna "true" se o id do vrtice para o qual "aux" esta a apontar for igual ao vrtice pretendido
-		aux = aux->proxVertice; // "aux" passa a apontar para o prximo vrtice
+		if (aux->id == idVertice) return true; // Retorna "true" se o id do vértice para o qual "aux" esta a apontar for igual ao vértice pretendido
+		aux = aux->proxVertice; // "aux" passa a apontar para o próximo vértice
 	}
 	return false;
 }
@@ -131,23 +141,60 @@ bool ExisteVertice(Vertice* inicio, int idVertice) {
 #pragma region ObterVertice
 
 /**
- * @brief Obtm um vrtice com um determinado identificador na lista de vrtices.
+ * @brief Obtém um vértice com um determinado identificador na lista de vértices.
  *
- * Esta funo percorre a lista de vrtices a partir do vrtice inicial e retorna
- * um apontador para o vrtice que possui o identificador especificado.
+ * Esta função percorre a lista de vértices a partir do vértice inicial e retorna
+ * um apontador para o vértice que possui o identificador especificado. Para muitas procuras
+ * na mesma lista deve ser usada IndexarVertices.
  *
- * @param inicio Apontador para o vrtice inicial da lista.
- * @param idVertice O identificador do vrtice a ser procurado.
- * @return Apontador para o vrtice com o identificador especificado, ou `NULL` se no for encontrado.
+ * @param inicio Apontador para o vértice inicial da lista.
+ * @param idVertice O identificador do vértice a ser procurado.
+ * @return Apontador para o vértice com o identificador especificado, ou `NULL` se não for encontrado.
  */
-Vertice* ObterVertice(Vertice* inicio, int idVertice) {
+Vertice* ObterVertice(Vertice* inicio, IdVertice idVertice) {
 	if (inicio == NULL) return NULL;
 	Vertice* aux = inicio;
 	while (aux) {
-		if (aux->id == idVertice) return aux; // Retorna "aux" se o id do vrtice para o qual "aux" esta a apontar for igual ao vrtice pretendido
-		aux = aux->proxVertice; // "aux" passa a apontar para o prximo vrtice
+		if (aux->id == idVertice) return aux; // Retorna "aux" se o id do vértice para o qual "aux" esta a apontar for igual ao vértice pretendido
+		aux = aux->proxVertice; // "aux" passa a apontar para o próximo vértice
+	}
+	return aux; // Retorna o vértice para o qual "aux" esta a apontar
+}
+
+/**
+ * @brief Cria uma tabela de identificadores sobre uma lista de vértices, para procuras em tempo constante.
+ *
+ * Cada identificador fica associado à posição do vértice no vetor devolvido, pelo que o vértice com um
+ * identificador é `vertices[ObterIndiceTabelaIds(ids, id)]`. Se um identificador se repetir na lista,
+ * fica a primeira ocorrência, como em ObterVertice. A tabela e o vetor são libertados por quem chama,
+ * com DestruirTabelaIds e free.
+ *
+ * @param inicio Apontador para o vértice inicial da lista.
+ * @param ids Apontador para a tabela a inicializar.
+ * @param numVertices Apontador para guardar o número de vértices indexados (pode ser NULL).
+ * @return O vetor dos vértices indexados, ou `NULL` se a alocação de memória falhar (a tabela fica vazia).
+ */
+Vertice** IndexarVertices(Vertice* inicio, TabelaIds* ids, int* numVertices) {
+	int total = 0;
+	for (Vertice* v = inicio; v != NULL; v = v->proxVertice) total++;
+
+	Vertice** vertices = (Vertice**)malloc((total > 0 ? total : 1) * sizeof(Vertice*));
+	if (vertices == NULL || !CriarTabelaIds(ids, total)) {
+		free(vertices);
+		return NULL;
+	}
+	int n = 0;
+	for (Vertice* v = inicio; v != NULL; v = v->proxVertice) {
+		if (ObterIndiceTabelaIds(ids, v->id) >= 0) continue; // Fica a primeira ocorrência
+		if (!InserirTabelaIds(ids, v->id, n)) {
+			DestruirTabelaIds(ids);
+			free(vertices);
+			return NULL;
+		}
+		vertices[n++] = v;
 	}
-	return aux; // Retorna o vrtice para o qual "aux" esta a apontar
+	if (numVertices != NULL) *numVertices = n;
+	return vertices;
 }
 
 #pragma endregion
@@ -155,38 +202,39 @@ Vertice* ObterVertice(Vertice* inicio, int idVertice) {
 #pragma region EliminarVertice
 
 /**
- * @brief Elimina um vrtice com um determinado identificador da lista de vrtices do grafo.
+ * @brief Elimina um vértice com um determinado identificador da lista de vértices do grafo.
  *
- * Esta funo procura um vrtice com o identificador especificado na lista de vrtices do grafo
- * e o elimina, mantendo a integridade da estrutura do grafo. Se o vrtice for encontrado e eliminado
- * com sucesso, o indicador de sucesso  atualizado para `true`.
+ * Esta função procura um vértice com o identificador especificado na lista de vértices do grafo
+ * e o elimina, mantendo a integridade da estrutura do grafo. Se o vértice for encontrado e eliminado
+ * com sucesso, o indicador de sucesso é atualizado para `true`.
  *
- * @param vertices Apontador para a cabea da lista de vrtices do grafo.
- * @param idVertice O identificador do vrtice a ser eliminado.
- * @param res Apontador para uma varivel booleana que indica o sucesso da eliminao.
- *            Ser definido como `true` se a eliminao for bem-sucedida, caso contrrio `false`.
- * @return Apontador para a cabea atualizada da lista de vrtices do grafo.
+ * @param vertices Apontador para a cabeça da lista de vértices do grafo.
+ * @param idVertice O identificador do vértice a ser eliminado.
+ * @param res Apontador para uma variável booleana que indica o sucesso da eliminação.
+ *            Será definido como `true` se a eliminação for bem-sucedida, caso contrário `false`.
+ * @return Apontador para a cabeça atualizada da lista de vértices do grafo.
  */
-Vertice* EliminarVertice(Vertice* vertices, int idVertice, bool* res) {
+Vertice* EliminarVertice(Vertice* vertices, IdVertice idVertice, bool* res) {
 	if (vertices == NULL) return NULL;
 	// Procurar vertice
 	Vertice* aux = vertices;
 	Vertice* anterior = NULL;
-	while (aux->id != idVertice) {
-		anterior = aux; // O vrtice "anterior" passa a apontar para o vrtice que "aux" estava a apontar
-		aux = aux->proxVertice;	// O vrtice "aux" passa a apontar para o prximo vrtice
+	while (aux != NULL && aux->id != idVertice) {
+		anterior = aux; // O vértice "anterior" passa a apontar para o vértice que "aux" estava a apontar
+		aux = aux->proxVertice;	// O vértice "aux" passa a apontar para o próximo vértice
 	}
-	if (!aux) return vertices; // Significa que o vrtice no existe
-	// Apaga o vrtice no incio
+	if (!aux) return vertices; // Significa que o vértice não existe
+	// Apaga o vértice no início
 	if (anterior == NULL) {
-		// Apaga todas as adjacncias do vrtice a eliminar
-		aux->proxAdjacente = EliminaTodosAdjacentes(aux->proxAdjacente, res); // Chama a funo para eliminar todas as adjacncias do vrtice para o qual "aux" estava a apontar
+		// Apaga todas as adjacências do vértice a eliminar
+		EliminaTodosAdjacentes(aux, res); // Chama a função para eliminar todas as adjacências do vértice para o qual "aux" estava a apontar
 		if (*res == false) return vertices;
-		vertices = aux->proxVertice; // "vertices" passa a apontar para o vrtice seguinte do que foi eliminado
+		vertices = aux->proxVertice; // "vertices" passa a apontar para o vértice seguinte do que foi eliminado
 	}
 	else {
-		anterior->proxVertice = aux->proxVertice; // "anterior" passa a apontar para o vrtice seguinte ao qual estava a ser apontado por "aux", eliminando assim o vrtice pretendido
+		anterior->proxVertice = aux->proxVertice; // "anterior" passa a apontar para o vértice seguinte ao qual estava a ser apontado por "aux", eliminando assim o vértice pretendido
 	}
+	if (aux->proxVertice != NULL) aux->proxVertice->antVertice = anterior; // Só depois de o vértice sair da lista
 	DestruirVertice(aux);
 	*res = true;
 	return vertices;
@@ -197,25 +245,25 @@ Vertice* EliminarVertice(Vertice* vertices, int idVertice, bool* res) {
 #pragma region EliminarAdjTodosVertices
 
 /**
- * @brief Elimina todas as adjacncias de um vrtice com um determinado identificador em todos os vrtices do grafo.
+ * @brief Elimina todas as adjacências de um vértice com um determinado identificador em todos os vértices do grafo.
  *
- * Esta funo percorre todos os vrtices do grafo e elimina a adjacncia com um vrtice especfico,
- * identificado pelo identificador `idVertice`. Se a eliminao for bem-sucedida em todos os vrtices, o indicador
- * de sucesso  definido como `true`.
+ * Esta função percorre todos os vértices do grafo e elimina a adjacência com um vértice específico,
+ * identificado pelo identificador `idVertice`. Se a eliminação for bem-sucedida em todos os vértices, o indicador
+ * de sucesso é definido como `true`.
  *
- * @param vertices Apontador para a cabea da lista de vrtices.
- * @param idVertice O identificador do vrtice cujas adjacncias devem ser eliminadas.
- * @param res Apontador para uma varivel booleana que indica o sucesso da eliminao das adjacncias.
- *            Ser definido como `true` se todas as adjacncias forem eliminadas com sucesso, caso contrrio `false`.
- * @return Apontador para a cabea atualizada da lista de vrtices aps a eliminao das adjacncias.
+ * @param vertices Apontador para a cabeça da lista de vértices.
+ * @param idVertice O identificador do vértice cujas adjacências devem ser eliminadas.
+ * @param res Apontador para uma variável booleana que indica o sucesso da eliminação das adjacências.
+ *            Será definido como `true` se todas as adjacências forem eliminadas com sucesso, caso contrário `false`.
+ * @return Apontador para a cabeça atualizada da lista de vértices após a eliminação das adjacências.
  */
-Vertice* EliminarAdjTodosVertices(Vertice* vertices, int idVertice, bool* res) {
+Vertice* EliminarAdjTodosVertices(Vertice* vertices, IdVertice idVertice, bool* res) {
 	*res = false;
 	if (vertices == NULL) return NULL;
 	Vertice* aux = vertices;
 	while (aux) {
-		aux->proxAdjacente = EliminarAdjacente(aux->proxAdjacente, idVertice, res); // Chama a funo para eliminar a adjacncia do vrtice para o qual "aux" estava a apontar
-		aux = aux->proxVertice; // O vrtice "aux" passa a apontar para o prximo vrtice
+		EliminarAdjacente(aux, idVertice, res); // Chama a função para eliminar a adjacência do vértice para o qual "aux" estava a apontar
+		aux = aux->proxVertice; // O vértice "aux" passa a apontar para o próximo vértice
 	}
 	*res = true;
 	return vertices;
@@ -226,31 +274,20 @@ Vertice* EliminarAdjTodosVertices(Vertice* vertices, int idVertice, bool* res) {
 #pragma region MostrarGrafo
 
 /**
- * @brief Mostra os vrtices e suas adjacncias no grafo.
+ * @brief Mostra os vértices e suas adjacências no grafo.
  *
- * Esta funo percorre a lista de vrtices do grafo e imprime cada vrtice com os seus adjacentes,
- * juntamente com os pesos das adjacncias. Os vrtices so mostrados na ordem em que aparecem na lista.
+ * Esta função percorre a lista de vértices do grafo e imprime cada vértice com os seus adjacentes,
+ * juntamente com os pesos das adjacências. Os vértices são mostrados na ordem em que aparecem na lista.
+ * O texto é escrito no stdout por ExportarVertices, através de um buffer; os destinos das adjacências são
+ * obtidos pela tabela de IndexarVertices, pelo que o custo é linear no número de vértices e de arestas.
  *
- * @param grafo Apontador para o vrtice inicial da lista de vrtices do grafo.
+ * @param grafo Apontador para o vértice inicial da lista de vértices do grafo.
  */
 void MostrarGrafo(Vertice* grafo) {
-	Vertice* atual = grafo;
-	printf("-----------------------------------------------------------------------");
-	while (atual != NULL) {
-		printf("\nVertice %d: %d\t", atual->id, atual->valor);
-		printf("\n\n\tAdjacentes:\t");
-		Adjacente* adjAtual = atual->proxAdjacente;
-		while (adjAtual != NULL) {
-			printf("Vertice %d:\t%d\t", adjAtual->id, adjAtual->valor);
-			printf("(Soma:%d)\n\t\t\t", adjAtual->peso);
-			adjAtual = adjAtual->proximo; // Passa para o prximo adjacente
-		}
-		printf("\n");
-		atual = atual->proxVertice; // Passa o prximo vrtice
-		printf("-----------------------------------------------------------------------");
-		printf("\n");
-	}
-
+	SaidaExportacao* s = CriarSaidaPadrao();
+	if (s == NULL) return;
+	ExportarVertices(s, grafo);
+	DestruirSaidaExportacao(s); // Escreve o que ficou no buffer
 }
 
 #pragma endregion